@@ -0,0 +1,204 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "BlockSummaries.h"
+
+#include <limits>
+
+static const quint64 NO_BLOCK = std::numeric_limits<quint64>::max();
+static const int TRIGRAM_LENGTH = 3;
+
+BlockSummaries::BlockSummaries(const size_t capacity)
+    : m_openBlock(NO_BLOCK)
+{
+    // live records span at most this many blocks
+    const int blocks = static_cast<int>(qMax(capacity, size_t(1)) / BLOCK_SIZE) + 2;
+    m_blocks.resize(blocks);
+    for (Block& block : m_blocks)
+    {
+        block.id = NO_BLOCK;
+    }
+}
+
+static inline quint64 foldCase(const QChar c)
+{
+    const ushort u = c.unicode();
+    if (u < 0x80)
+    {
+        return u >= 'A' && u <= 'Z' ? u | 0x20 : u;
+    }
+    return QChar::toCaseFolded(u);
+}
+
+quint64 BlockSummaries::hashTrigram(const QChar* text)
+{
+    // trigrams are case folded, so the summaries serve case insensitive searches as well;
+    // the hash is the 64-bit finalizer of MurmurHash3
+    quint64 h = (foldCase(text[0]) << 32) | (foldCase(text[1]) << 16) | foldCase(text[2]);
+    h ^= h >> 33;
+    h *= Q_UINT64_C(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    h *= Q_UINT64_C(0xc4ceb9fe1a85ec53);
+    h ^= h >> 33;
+    return h;
+}
+
+void BlockSummaries::add(const quint64 id, const QStringRef& text, const RecordFields& fields)
+{
+    const quint64 blockId = id / BLOCK_SIZE;
+    if (blockId != m_openBlock)
+    {
+        closeOpenBlock();
+        m_openBlock = blockId;
+    }
+
+    Block& block = m_blocks[static_cast<int>(blockId % m_blocks.size())];
+    if (block.id != blockId)
+    {
+        block.id = blockId;
+        block.bloom.clear();
+        for (int value = 0; value < RecordFields::VALUES; ++value)
+        {
+            block.minValues[value] = std::numeric_limits<qint64>::max();
+            block.maxValues[value] = std::numeric_limits<qint64>::min();
+        }
+    }
+
+    const QChar* const data = text.unicode();
+    for (int i = 0; i + TRIGRAM_LENGTH <= text.length(); ++i)
+    {
+        m_openTrigrams.insert(hashTrigram(data + i));
+    }
+
+    for (int value = 0; value < RecordFields::VALUES; ++value)
+    {
+        const qint64 x = fields.values[value];
+        if (x != RecordFields::NO_VALUE)
+        {
+            block.minValues[value] = qMin(block.minValues[value], x);
+            block.maxValues[value] = qMax(block.maxValues[value], x);
+        }
+    }
+}
+
+void BlockSummaries::closeOpenBlock()
+{
+    if (m_openBlock != NO_BLOCK)
+    {
+        Block& block = m_blocks[static_cast<int>(m_openBlock % m_blocks.size())];
+        const qint64 bits = qint64(m_openTrigrams.size()) * BLOOM_BITS_PER_TRIGRAM;
+        if (block.id == m_openBlock && bits <= MAX_BLOOM_BITS)
+        {
+            block.bloom.fill(0, static_cast<int>(bits / 64) + 1);
+            const quint32 bloomBits = static_cast<quint32>(block.bloom.size()) * 64;
+            quint64* const bloom = block.bloom.data();
+            for (const quint64 h : m_openTrigrams)
+            {
+                const quint32 h1 = static_cast<quint32>(h);
+                const quint32 h2 = static_cast<quint32>(h >> 32);
+                for (int k = 0; k < BLOOM_HASHES; ++k)
+                {
+                    const quint32 bit = (h1 + k * h2) % bloomBits;
+                    bloom[bit / 64] |= quint64(1) << (bit % 64);
+                }
+            }
+        }
+    }
+    m_openTrigrams.clear();
+}
+
+const BlockSummaries::Block* BlockSummaries::findBlock(const quint64 block) const
+{
+    const Block& result = m_blocks[static_cast<int>(block % m_blocks.size())];
+    return result.id == block ? &result : nullptr;
+}
+
+bool BlockSummaries::mayContain(const quint64 blockId, const Block& block, const QVector<quint64>& trigrams) const
+{
+    if (blockId == m_openBlock)
+    {
+        for (const quint64 h : trigrams)
+        {
+            if (!m_openTrigrams.contains(h))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (block.bloom.isEmpty())
+    {
+        return true;
+    }
+
+    const quint32 bloomBits = static_cast<quint32>(block.bloom.size()) * 64;
+    const quint64* const bloom = block.bloom.constData();
+    for (const quint64 h : trigrams)
+    {
+        const quint32 h1 = static_cast<quint32>(h);
+        const quint32 h2 = static_cast<quint32>(h >> 32);
+        for (int k = 0; k < BLOOM_HASHES; ++k)
+        {
+            const quint32 bit = (h1 + k * h2) % bloomBits;
+            if ((bloom[bit / 64] & (quint64(1) << (bit % 64))) == 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool BlockSummaries::findRangesContaining(const QStringRef& term, const quint64 firstId, const quint64 endId, QVector<IdRange>& ranges) const
+{
+    ranges.clear();
+    if (term.length() < TRIGRAM_LENGTH)
+    {
+        return false;
+    }
+
+    QVector<quint64> trigrams;
+    for (int i = 0; i + TRIGRAM_LENGTH <= term.length(); ++i)
+    {
+        trigrams.append(hashTrigram(term.unicode() + i));
+    }
+
+    for (quint64 blockId = firstId / BLOCK_SIZE; blockId * BLOCK_SIZE < endId; ++blockId)
+    {
+        const Block* const block = findBlock(blockId);
+        if (block == nullptr || mayContain(blockId, *block, trigrams))
+        {
+            IdRange::append(ranges, qMax(firstId, blockId * BLOCK_SIZE), qMin(endId, (blockId + 1) * BLOCK_SIZE));
+        }
+    }
+
+    return true;
+}
+
+void BlockSummaries::findRangesWithValueIn(const RecordFields::Value value, const qint64 min, const qint64 max, const quint64 firstId, const quint64 endId, QVector<IdRange>& ranges) const
+{
+    ranges.clear();
+    for (quint64 blockId = firstId / BLOCK_SIZE; blockId * BLOCK_SIZE < endId; ++blockId)
+    {
+        const Block* const block = findBlock(blockId);
+        if (block == nullptr || (block->minValues[value] <= max && block->maxValues[value] >= min))
+        {
+            IdRange::append(ranges, qMax(firstId, blockId * BLOCK_SIZE), qMin(endId, (blockId + 1) * BLOCK_SIZE));
+        }
+    }
+}
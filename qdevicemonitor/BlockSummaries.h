@@ -0,0 +1,73 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BLOCKSUMMARIES_H
+#define BLOCKSUMMARIES_H
+
+#include "RecordIndex.h"
+
+#include <QSet>
+#include <QStringRef>
+#include <QVector>
+
+// Summaries of consecutive blocks of BLOCK_SIZE records:
+// a Bloom filter of the text trigrams and the range of every value.
+// Blocks which can't contain a term or a value are skipped by searches.
+// The block being filled keeps its trigrams in a set; its filter is built
+// once the block is complete, sized for the number of distinct trigrams.
+class BlockSummaries
+{
+public:
+    static const int BLOCK_SIZE = 1024;
+    // about 1% false positives per trigram with 4 hashes
+    static const int BLOOM_BITS_PER_TRIGRAM = 10;
+    static const int BLOOM_HASHES = 4;
+    // blocks with more distinct trigrams would pass nearly every term, so they aren't summarized
+    static const int MAX_BLOOM_BITS = 128 * 1024;
+
+    typedef RecordIdRange IdRange;
+
+private:
+    struct Block
+    {
+        quint64 id;
+        QVector<quint64> bloom; // empty if the text of the block isn't summarized
+        qint64 minValues[RecordFields::VALUES];
+        qint64 maxValues[RecordFields::VALUES];
+    };
+
+    QVector<Block> m_blocks;
+    quint64 m_openBlock;
+    QSet<quint64> m_openTrigrams;
+
+public:
+    explicit BlockSummaries(const size_t capacity);
+
+    void add(const quint64 id, const QStringRef& text, const RecordFields& fields);
+
+    // returns false if the term is too short to be looked up
+    bool findRangesContaining(const QStringRef& term, const quint64 firstId, const quint64 endId, QVector<IdRange>& ranges) const;
+    void findRangesWithValueIn(const RecordFields::Value value, const qint64 min, const qint64 max, const quint64 firstId, const quint64 endId, QVector<IdRange>& ranges) const;
+
+private:
+    void closeOpenBlock();
+    const Block* findBlock(const quint64 block) const;
+    bool mayContain(const quint64 blockId, const Block& block, const QVector<quint64>& trigrams) const;
+    static quint64 hashTrigram(const QChar* text);
+};
+
+#endif // BLOCKSUMMARIES_H
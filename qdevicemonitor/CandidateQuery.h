@@ -0,0 +1,216 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CANDIDATEQUERY_H
+#define CANDIDATEQUERY_H
+
+#include "RecordIdList.h"
+#include "ValueColumn.h"
+
+#include <QVector>
+
+// The lines which may match a filter. The GUI thread only takes implicitly shared
+// copies of the posting lists and value columns the filter terms need; collect()
+// unites, scans, expands and intersects them in a worker thread, since that takes
+// time linear in the log buffer.
+struct CandidateQuery
+{
+    struct ValueTerm
+    {
+        ValueColumn values;
+        qint64 min;
+        qint64 max;
+        // the blocks whose values may be in the range
+        QVector<RecordIdRange> ranges;
+    };
+
+    struct Result
+    {
+        RecordIdList ids;
+        // the lines from beginId can match only if they're candidates
+        quint64 beginId = 0;
+        int generation = 0;
+    };
+
+    quint64 firstId = 0;
+    quint64 endId = 0;
+    int generation = 0;
+
+    // every indexed term narrows the candidates down: a key term to the union of the posting
+    // lists of the keys containing it, a value term to the ids with a value in its range,
+    // a text term to ranges of ids
+    QVector<QVector<RecordIdList>> keyTerms;
+    QVector<ValueTerm> valueTerms;
+    QVector<QVector<RecordIdRange>> ranges;
+
+    // only the previous candidates and matches and the lines that were never filtered can match a refinement
+    bool refinement = false;
+    RecordIdList previousCandidates;
+    int previousCandidateCount = 0;
+    quint64 previousCandidatesBeginId = 0;
+    RecordIdList previousMatches;
+    quint64 previousMatchedEndId = 0;
+
+    inline bool isIndexed() const { return !keyTerms.isEmpty() || !valueTerms.isEmpty() || !ranges.isEmpty(); }
+
+    static Result collect(const CandidateQuery& query)
+    {
+        Result result;
+        result.beginId = query.endId;
+        result.generation = query.generation;
+
+        RecordIdList candidates;
+        if (query.refinement)
+        {
+            for (int i = 0; i < query.previousCandidateCount; ++i)
+            {
+                const quint64 id = query.previousCandidates.at(i);
+                if (id >= query.firstId)
+                {
+                    candidates.append(id);
+                }
+            }
+            for (const quint64 id : query.previousMatches)
+            {
+                candidates.append(id);
+            }
+            for (quint64 id = qMax(query.previousMatchedEndId, query.firstId); id < query.endId; ++id)
+            {
+                candidates.append(id);
+            }
+            result.beginId = qMax(query.previousCandidatesBeginId, query.firstId);
+        }
+
+        if (query.isIndexed())
+        {
+            const RecordIdList indexedCandidates = intersectTerms(query);
+            if (query.refinement)
+            {
+                // the index covers the lines which were never filtered too
+                QVector<quint64> head;
+                for (const quint64 id : indexedCandidates)
+                {
+                    if (id >= result.beginId)
+                    {
+                        break;
+                    }
+                    head.append(id);
+                }
+                candidates = RecordIdList::intersect(candidates, indexedCandidates);
+                candidates.prepend(head);
+            }
+            else
+            {
+                candidates = indexedCandidates;
+            }
+            result.beginId = query.firstId;
+        }
+
+        result.ids = candidates;
+        return result;
+    }
+
+    static QVector<RecordIdRange> intersectRanges(const QVector<RecordIdRange>& a, const QVector<RecordIdRange>& b)
+    {
+        QVector<RecordIdRange> result;
+        int i = 0;
+        int j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            const quint64 begin = qMax(a[i].begin, b[j].begin);
+            const quint64 end = qMin(a[i].end, b[j].end);
+            if (begin < end)
+            {
+                RecordIdRange::append(result, begin, end);
+            }
+
+            if (a[i].end <= b[j].end)
+            {
+                ++i;
+            }
+            else
+            {
+                ++j;
+            }
+        }
+        return result;
+    }
+
+    static RecordIdList intersectTerms(const CandidateQuery& query)
+    {
+        // the ranges are intersected first, so they're expanded at most once
+        QVector<RecordIdRange> ranges;
+        for (int i = 0; i < query.ranges.size(); ++i)
+        {
+            ranges = i == 0 ? query.ranges[i] : intersectRanges(ranges, query.ranges[i]);
+        }
+
+        QVector<RecordIdList> lists;
+        for (const QVector<RecordIdList>& postings : query.keyTerms)
+        {
+            lists.append(RecordIdList::uniteAll(postings));
+        }
+        for (const ValueTerm& term : query.valueTerms)
+        {
+            lists.append(term.values.getIdsInRange(term.min, term.max, term.ranges));
+        }
+
+        RecordIdList ids;
+        if (lists.isEmpty())
+        {
+            for (const RecordIdRange& range : ranges)
+            {
+                for (quint64 id = range.begin; id < range.end; ++id)
+                {
+                    ids.append(id);
+                }
+            }
+            return ids;
+        }
+
+        ids = lists.first();
+        for (int i = 1; i < lists.size(); ++i)
+        {
+            ids = RecordIdList::intersect(ids, lists[i]);
+        }
+
+        if (query.ranges.isEmpty())
+        {
+            return ids;
+        }
+
+        RecordIdList idsInRanges;
+        int range = 0;
+        for (const quint64 id : ids)
+        {
+            while (range < ranges.size() && ranges[range].end <= id)
+            {
+                ++range;
+            }
+            if (range == ranges.size())
+            {
+                break;
+            }
+            else if (ranges[range].begin <= id)
+            {
+                idsInRanges.append(id);
+            }
+        }
+        return idsInRanges;
+    }
+};
+
+#endif // CANDIDATEQUERY_H
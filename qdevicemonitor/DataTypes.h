@@ -53,6 +53,8 @@ namespace DataTypes
         Debug,
         Verbose
     };
+
+    static const int VERBOSITY_LEVELS = Verbose + 1;
 }
 
 #endif // DATATYPES_H
@@ -0,0 +1,133 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KEYINDEX_H
+#define KEYINDEX_H
+
+#include "RecordIdList.h"
+#include "TextSearch.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+// Inverted index from interned column values (tags, pids) to record ids.
+// Holds at most `capacity` latest records, like the log buffer it indexes.
+class KeyIndex
+{
+    struct Entry
+    {
+        QString value;
+        RecordIdList ids;
+    };
+
+    QHash<QString, int> m_entryByValue;
+    QVector<Entry> m_entries;
+    QVector<int> m_freeEntries;
+    QVector<int> m_recordEntries;
+
+public:
+    explicit KeyIndex(const int capacity = 1)
+        : m_recordEntries(capacity, -1)
+    {
+    }
+
+    void add(const quint64 id, const QStringRef& value)
+    {
+        const int slot = static_cast<int>(id % m_recordEntries.size());
+        if (id >= static_cast<quint64>(m_recordEntries.size()))
+        {
+            evict(id - m_recordEntries.size());
+        }
+
+        if (value.isEmpty())
+        {
+            m_recordEntries[slot] = -1;
+            return;
+        }
+
+        const QString valueString(value.toString());
+        auto it = m_entryByValue.constFind(valueString);
+        int entry = 0;
+        if (it != m_entryByValue.constEnd())
+        {
+            entry = *it;
+        }
+        else if (!m_freeEntries.isEmpty())
+        {
+            entry = m_freeEntries.takeLast();
+            m_entries[entry].value = valueString;
+            m_entryByValue.insert(valueString, entry);
+        }
+        else
+        {
+            entry = m_entries.size();
+            m_entries.append(Entry());
+            m_entries[entry].value = valueString;
+            m_entryByValue.insert(valueString, entry);
+        }
+
+        m_entries[entry].ids.append(id);
+        m_recordEntries[slot] = entry;
+    }
+
+    // the lists are implicitly shared copies, so they can be united by a worker thread
+    QVector<RecordIdList> getPostingsContaining(const QStringRef& value, const Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    {
+        QVector<RecordIdList> postings;
+        for (const Entry& entry : m_entries)
+        {
+            if (!entry.ids.isEmpty() && TextSearch::contains(QStringRef(&entry.value), value, cs))
+            {
+                postings.append(entry.ids);
+            }
+        }
+        return postings;
+    }
+
+    RecordIdList getIdsContaining(const QStringRef& value, const Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    {
+        return RecordIdList::uniteAll(getPostingsContaining(value, cs));
+    }
+
+    inline int getDistinctValues() const { return m_entryByValue.size(); }
+
+private:
+    void evict(const quint64 id)
+    {
+        const int slot = static_cast<int>(id % m_recordEntries.size());
+        const int entry = m_recordEntries[slot];
+        if (entry < 0)
+        {
+            return;
+        }
+
+        RecordIdList& ids = m_entries[entry].ids;
+        ids.trim(id + 1);
+        if (ids.isEmpty())
+        {
+            ids.clear();
+            m_entryByValue.remove(m_entries[entry].value);
+            m_entries[entry].value.clear();
+            m_freeEntries.append(entry);
+        }
+        m_recordEntries[slot] = -1;
+    }
+};
+
+#endif // KEYINDEX_H
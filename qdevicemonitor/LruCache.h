@@ -0,0 +1,89 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <QList>
+#include <QPair>
+
+// Small cache which drops the least recently used entries first.
+// Lookups are linear, so it's meant for a handful of entries.
+template <typename Key, typename Value>
+class LruCache
+{
+    QList<QPair<Key, Value>> m_entries;
+    int m_capacity;
+
+public:
+    explicit LruCache(const int capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    void insert(const Key& key, const Value& value)
+    {
+        remove(key);
+        m_entries.prepend(qMakePair(key, value));
+        while (m_entries.size() > m_capacity)
+        {
+            m_entries.removeLast();
+        }
+    }
+
+    // moves the value out of the cache
+    bool take(const Key& key, Value& value)
+    {
+        for (int i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].first == key)
+            {
+                value = m_entries.takeAt(i).second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void remove(const Key& key)
+    {
+        for (int i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].first == key)
+            {
+                m_entries.removeAt(i);
+                return;
+            }
+        }
+    }
+
+    // updates every cached value in place, without changing their order
+    template <typename Function>
+    void forEachValue(Function function)
+    {
+        for (auto& entry : m_entries)
+        {
+            function(entry.second);
+        }
+    }
+
+    inline void clear() { m_entries.clear(); }
+    inline int size() const { return m_entries.size(); }
+    inline int getCapacity() const { return m_capacity; }
+};
+
+#endif // LRUCACHE_H
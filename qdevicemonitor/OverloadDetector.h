@@ -0,0 +1,117 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OVERLOADDETECTOR_H
+#define OVERLOADDETECTOR_H
+
+#include <QtGlobal>
+
+// Tells when the lines of a device come faster than they can be rendered.
+// It's updated after every read of the log with the count of lines read and whether
+// some were left unread. Rendering is overloaded once unread lines are left for ENTER_LAG ms;
+// the lines read meanwhile give the rate they could be rendered at. It catches up once no lines
+// were left unread for LEAVE_CALM ms and the rate is below LEAVE_RATE_PERCENT of that one,
+// so a device logging about as fast as it's rendered doesn't switch back and forth.
+class OverloadDetector
+{
+public:
+    static const qint64 ENTER_LAG = 1000;
+    static const qint64 RATE_WINDOW = 1000;
+    static const qint64 LEAVE_CALM = 2 * RATE_WINDOW;
+    static const int LEAVE_RATE_PERCENT = 50;
+
+private:
+    bool m_overloaded;
+    qint64 m_backlogSince;
+    qint64 m_backlogLines;
+    int m_renderRate;
+    qint64 m_calmTime;
+    qint64 m_windowBegin;
+    qint64 m_windowLines;
+    bool m_windowBacklog;
+    int m_rate;
+
+public:
+    OverloadDetector()
+        : m_overloaded(false)
+        , m_backlogSince(-1)
+        , m_backlogLines(0)
+        , m_renderRate(0)
+        , m_calmTime(0)
+        , m_windowBegin(0)
+        , m_windowLines(0)
+        , m_windowBacklog(false)
+        , m_rate(0)
+    {
+    }
+
+    // now is in ms; returns true if the overloaded state has changed
+    bool update(const qint64 now, const int lines, const bool backlog)
+    {
+        m_windowLines += lines;
+        m_windowBacklog = m_windowBacklog || backlog;
+
+        const qint64 windowTime = now - m_windowBegin;
+        if (windowTime >= RATE_WINDOW)
+        {
+            m_rate = static_cast<int>(m_windowLines * 1000 / windowTime);
+            m_calmTime = m_windowBacklog ? 0 : m_calmTime + windowTime;
+            m_windowBegin = now;
+            m_windowLines = 0;
+            m_windowBacklog = false;
+        }
+
+        if (!backlog)
+        {
+            m_backlogSince = -1;
+            m_backlogLines = 0;
+        }
+        else
+        {
+            if (m_backlogSince < 0)
+            {
+                m_backlogSince = now;
+            }
+            m_backlogLines += lines;
+        }
+
+        if (!m_overloaded && m_backlogSince >= 0 && now - m_backlogSince >= ENTER_LAG)
+        {
+            // the lines were read as fast as they could be rendered meanwhile
+            m_renderRate = static_cast<int>(m_backlogLines * 1000 / (now - m_backlogSince));
+            m_calmTime = 0;
+            m_overloaded = true;
+            return true;
+        }
+        else if (m_overloaded && m_calmTime >= LEAVE_CALM && qint64(m_rate) * 100 <= qint64(m_renderRate) * LEAVE_RATE_PERCENT)
+        {
+            m_overloaded = false;
+            return true;
+        }
+        return false;
+    }
+
+    inline bool isOverloaded() const { return m_overloaded; }
+
+    // lines/s over the last whole window
+    inline int getRate() const { return m_rate; }
+
+    // lines/s rendered before the last overload
+    inline int getRenderRate() const { return m_renderRate; }
+};
+
+#endif // OVERLOADDETECTOR_H
@@ -0,0 +1,165 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RECORDIDLIST_H
+#define RECORDIDLIST_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include <algorithm>
+
+// Half-open range of record ids; ranges are kept ascending and disjoint
+struct RecordIdRange
+{
+    quint64 begin;
+    quint64 end;
+
+    // extends the last range if it ends where the new one begins
+    static void append(QVector<RecordIdRange>& ranges, const quint64 begin, const quint64 end)
+    {
+        if (!ranges.isEmpty() && ranges.last().end == begin)
+        {
+            ranges.last().end = end;
+        }
+        else
+        {
+            ranges.append({ begin, end });
+        }
+    }
+};
+
+// Ascending list of StringRingBuffer record ids.
+// Evicted ids are dropped from the front lazily, so trim() is amortized O(1).
+class RecordIdList
+{
+    QVector<quint64> m_ids;
+    int m_offset;
+
+public:
+    RecordIdList()
+        : m_offset(0)
+    {
+    }
+
+    void append(const quint64 id)
+    {
+        Q_ASSERT_X(isEmpty() || last() < id, "RecordIdList::append", "ids must be ascending");
+        m_ids.append(id);
+    }
+
+    // ids must be ascending and less than the first one of the list
+    void prepend(const QVector<quint64>& ids)
+    {
+        Q_ASSERT_X(ids.isEmpty() || isEmpty() || ids.last() < at(0), "RecordIdList::prepend", "ids must be ascending");
+        QVector<quint64> merged;
+        merged.reserve(ids.size() + size());
+        merged += ids;
+        for (const quint64 id : *this)
+        {
+            merged.append(id);
+        }
+        m_ids = merged;
+        m_offset = 0;
+    }
+
+    void clear()
+    {
+        m_ids.clear();
+        m_offset = 0;
+    }
+
+    void trim(const quint64 firstId)
+    {
+        while (m_offset < m_ids.size() && m_ids[m_offset] < firstId)
+        {
+            ++m_offset;
+        }
+
+        if (m_offset > 0 && m_offset * 2 >= m_ids.size())
+        {
+            m_ids.remove(0, m_offset);
+            m_offset = 0;
+        }
+    }
+
+    inline int size() const { return m_ids.size() - m_offset; }
+    inline bool isEmpty() const { return size() == 0; }
+    inline quint64 at(const int i) const { return m_ids[m_offset + i]; }
+    inline quint64 last() const { return m_ids.last(); }
+
+    inline const quint64* begin() const { return m_ids.constData() + m_offset; }
+    inline const quint64* end() const { return m_ids.constData() + m_ids.size(); }
+
+    static RecordIdList unite(const RecordIdList& a, const RecordIdList& b)
+    {
+        RecordIdList result;
+        result.m_ids.resize(a.size() + b.size());
+        quint64* const resultEnd = std::set_union(a.begin(), a.end(), b.begin(), b.end(), result.m_ids.data());
+        result.m_ids.resize(static_cast<int>(resultEnd - result.m_ids.constData()));
+        return result;
+    }
+
+    static RecordIdList uniteAll(const QVector<RecordIdList>& lists)
+    {
+        if (lists.size() == 1)
+        {
+            return lists.first();
+        }
+
+        RecordIdList result;
+        for (const RecordIdList& ids : lists)
+        {
+            for (const quint64 id : ids)
+            {
+                result.m_ids.append(id);
+            }
+        }
+        std::sort(result.m_ids.begin(), result.m_ids.end());
+        result.m_ids.erase(std::unique(result.m_ids.begin(), result.m_ids.end()), result.m_ids.end());
+        return result;
+    }
+
+    static RecordIdList intersect(const RecordIdList& a, const RecordIdList& b)
+    {
+        const RecordIdList& smaller = a.size() <= b.size() ? a : b;
+        const RecordIdList& larger = a.size() <= b.size() ? b : a;
+
+        RecordIdList result;
+        result.m_ids.reserve(smaller.size());
+
+        // a posting list of a rare value is usually much shorter than the other one,
+        // so the larger list is searched instead of being walked entirely
+        const quint64* it = larger.begin();
+        for (const quint64 id : smaller)
+        {
+            it = std::lower_bound(it, larger.end(), id);
+            if (it == larger.end())
+            {
+                break;
+            }
+            else if (*it == id)
+            {
+                result.m_ids.append(id);
+            }
+        }
+
+        return result;
+    }
+};
+
+#endif // RECORDIDLIST_H
@@ -0,0 +1,71 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RecordIndex.h"
+
+#include <algorithm>
+
+using namespace DataTypes;
+
+RecordIndex::RecordIndex(const size_t capacity)
+    : m_fields(static_cast<int>(qMax(capacity, size_t(1))))
+    , m_keyIndexes(KEYS, KeyIndex(m_fields.size()))
+{
+    const qint64 noValue = RecordFields::NO_VALUE;
+    for (auto& values : m_values)
+    {
+        values = ValueColumn(m_fields.size(), noValue);
+    }
+}
+
+void RecordIndex::add(const quint64 id, const RecordFields& fields, const QStringRef keys[KEYS])
+{
+    const int slot = static_cast<int>(id % m_fields.size());
+    const quint64 capacity = static_cast<quint64>(m_fields.size());
+    if (id >= capacity)
+    {
+        // the evicted record is the first one of its level
+        m_verbosityIds[m_fields[slot].verbosity].trim(id - capacity + 1);
+    }
+    m_fields[slot] = fields;
+    m_verbosityIds[fields.verbosity].append(id);
+    for (int value = 0; value < RecordFields::VALUES; ++value)
+    {
+        m_values[value].set(slot, fields.values[value]);
+    }
+
+    for (int key = 0; key < KEYS; ++key)
+    {
+        m_keyIndexes[key].add(id, keys[key]);
+    }
+}
+
+bool RecordIndex::findPreviousUpToVerbosityLevel(const int level, const quint64 endId, quint64& id) const
+{
+    bool found = false;
+    for (int i = 0; i <= level && i < VERBOSITY_LEVELS; ++i)
+    {
+        const RecordIdList& ids = m_verbosityIds[i];
+        const quint64* const it = std::lower_bound(ids.begin(), ids.end(), endId);
+        if (it != ids.begin() && (!found || *(it - 1) > id))
+        {
+            id = *(it - 1);
+            found = true;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,122 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RECORDINDEX_H
+#define RECORDINDEX_H
+
+#include "DataTypes.h"
+#include "KeyIndex.h"
+#include "RecordIdList.h"
+#include "ValueColumn.h"
+
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+// Columns of a log line, parsed once when the line is added to the buffer
+struct RecordFields
+{
+    static const int MAX_COLUMNS = 7;
+
+    // integer values of the columns, for typed filters
+    enum Value
+    {
+        PidValue,
+        TidValue,
+        TimeValue,
+        TimestampValue
+    };
+
+    static const int VALUES = TimestampValue + 1;
+    static const qint64 NO_VALUE = -1;
+    static const qint64 MSECS_PER_DAY = 24 * 60 * 60 * 1000;
+
+    struct Column
+    {
+        int position;
+        int length;
+    };
+
+    DataTypes::VerbosityEnum verbosity;
+    int columnCount;
+    Column columns[MAX_COLUMNS];
+    qint64 values[VALUES];
+
+    RecordFields()
+        : verbosity(DataTypes::Verbose)
+        , columnCount(0)
+    {
+        for (int i = 0; i < VALUES; ++i)
+        {
+            values[i] = NO_VALUE;
+        }
+    }
+
+    // ordered within a year, the logs have no year anyway
+    static inline qint64 makeTimestamp(const int month, const int day, const qint64 msecsOfDay)
+    {
+        return (month * 32 + day) * MSECS_PER_DAY + msecsOfDay;
+    }
+
+    inline bool isParsed() const { return columnCount > 0; }
+
+    void setColumn(const int column, const QStringRef& value)
+    {
+        columns[column].position = value.position();
+        columns[column].length = value.length();
+        columnCount = qMax(columnCount, column + 1);
+    }
+
+    inline QStringRef getColumn(const QString& line, const int column) const
+    {
+        return line.midRef(columns[column].position, columns[column].length);
+    }
+};
+
+// Per record data maintained at ingest, addressed by StringRingBuffer record ids
+class RecordIndex
+{
+public:
+    enum Key
+    {
+        TagKey,
+        PidKey
+    };
+
+    static const int KEYS = PidKey + 1;
+
+private:
+    QVector<RecordFields> m_fields;
+    RecordIdList m_verbosityIds[DataTypes::VERBOSITY_LEVELS];
+    QVector<KeyIndex> m_keyIndexes;
+    ValueColumn m_values[RecordFields::VALUES];
+
+public:
+    explicit RecordIndex(const size_t capacity);
+
+    void add(const quint64 id, const RecordFields& fields, const QStringRef keys[KEYS]);
+
+    inline const RecordFields& getFields(const quint64 id) const { return m_fields[static_cast<int>(id % m_fields.size())]; }
+    inline QVector<RecordIdList> getPostingsWithKeyContaining(const Key key, const QStringRef& value, const Qt::CaseSensitivity cs) const { return m_keyIndexes[key].getPostingsContaining(value, cs); }
+    inline const ValueColumn& getValues(const RecordFields::Value value) const { return m_values[value]; }
+
+    // the newest record before endId whose verbosity is at most level, so the rendering
+    // can skip the matches of the hidden levels; returns false if there's none
+    bool findPreviousUpToVerbosityLevel(const int level, const quint64 endId, quint64& id) const;
+};
+
+#endif // RECORDINDEX_H
@@ -0,0 +1,136 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include "RecordIdList.h"
+#include "TextSearch.h"
+#include "ui/LogModel.h"
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <QStringRef>
+#include <QVector>
+
+#include <algorithm>
+
+// Ids of the log buffer lines which contain any of the search terms anywhere, whatever
+// the column. The lines are searched as the LogSource formats them, so the matches are
+// the ones highlighted. The lines pushed after a restart are added as they come, the older
+// ones are searched newest first by searchOlder() in slices of at most maxTime ms.
+class SearchIndex
+{
+public:
+    static const int TIME_CHECK_LINES = 256;
+
+private:
+    QStringList m_terms;
+    Qt::CaseSensitivity m_caseSensitivity;
+    RecordIdList m_ids;
+    quint64 m_searchedBeginId;
+    LogLine m_line;
+
+public:
+    SearchIndex()
+        : m_caseSensitivity(Qt::CaseSensitive)
+        , m_searchedBeginId(0)
+    {
+    }
+
+    // returns false if the terms haven't changed, otherwise the search restarts from endId
+    bool setTerms(const QStringList& terms, const Qt::CaseSensitivity cs, const quint64 endId)
+    {
+        if (terms == m_terms && cs == m_caseSensitivity)
+        {
+            return false;
+        }
+
+        m_terms = terms;
+        m_terms.removeAll(QString());
+        m_caseSensitivity = cs;
+        restart(endId);
+        return true;
+    }
+
+    void restart(const quint64 endId)
+    {
+        m_ids.clear();
+        m_searchedBeginId = endId;
+    }
+
+    // the lines must be added in the order they're pushed
+    void add(const quint64 id, const LogSource& source)
+    {
+        if (contains(id, source))
+        {
+            m_ids.append(id);
+        }
+    }
+
+    void searchOlder(const LogSource& source, const quint64 firstId, const int maxTime)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        m_searchedBeginId = qMax(m_searchedBeginId, firstId);
+        QVector<quint64> matches;
+        for (int lines = 0; m_searchedBeginId > firstId; ++lines)
+        {
+            if (lines % TIME_CHECK_LINES == 0 && timer.elapsed() >= maxTime)
+            {
+                break;
+            }
+
+            --m_searchedBeginId;
+            if (contains(m_searchedBeginId, source))
+            {
+                matches.append(m_searchedBeginId);
+            }
+        }
+
+        m_ids.trim(firstId);
+        std::reverse(matches.begin(), matches.end());
+        m_ids.prepend(matches);
+    }
+
+    inline void trim(const quint64 firstId) { m_ids.trim(firstId); }
+    inline bool hasTerms() const { return !m_terms.isEmpty(); }
+    inline bool isDone(const quint64 firstId) const { return m_terms.isEmpty() || m_searchedBeginId <= firstId; }
+    inline const RecordIdList& getIds() const { return m_ids; }
+
+    // the lines from this id on are all searched
+    inline quint64 getSearchedBeginId() const { return m_searchedBeginId; }
+
+private:
+    bool contains(const quint64 id, const LogSource& source)
+    {
+        m_line.clear();
+        source.formatRecord(id, m_line);
+        for (const QString& term : m_terms)
+        {
+            if (TextSearch::contains(QStringRef(&m_line.text), QStringRef(&term), m_caseSensitivity))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // SEARCHINDEX_H
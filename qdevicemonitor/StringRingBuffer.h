@@ -29,6 +29,7 @@ class StringRingBuffer : public QObject
     QVector<QString> m_data;
     size_t m_begin;
     size_t m_size;
+    quint64 m_endId;
 
     StringRingBuffer()
     {
@@ -44,6 +45,7 @@ public:
         : m_data(capacity)
         , m_begin(0)
         , m_size(0)
+        , m_endId(0)
     {
     }
 
@@ -51,7 +53,8 @@ public:
     {
     }
 
-    void push(const QString& text)
+    // returns id of the pushed record; ids are never reused
+    quint64 push(const QString& text)
     {
         if (m_size < static_cast<size_t>(m_data.capacity()))
         {
@@ -63,6 +66,28 @@ public:
             m_data[(m_begin + m_size) % m_size] = text;
             ++m_begin;
         }
+        return m_endId++;
+    }
+
+    const QString& at(const quint64 id) const
+    {
+        Q_ASSERT_X(contains(id), "StringRingBuffer::at", "record is evicted or not pushed yet");
+        return m_data[(m_begin + static_cast<size_t>(id - getFirstId())) % m_size];
+    }
+
+    bool contains(const quint64 id) const
+    {
+        return id >= getFirstId() && id < m_endId;
+    }
+
+    quint64 getFirstId() const
+    {
+        return m_endId - m_size;
+    }
+
+    quint64 getEndId() const
+    {
+        return m_endId;
     }
 
     class ConstIterator;
@@ -77,6 +102,20 @@ public:
         return m_data.size();
     }
 
+    // keeps the newest records which fit, along with their ids
+    void setCapacity(const size_t capacity)
+    {
+        const size_t size = qMin(m_size, capacity);
+        QVector<QString> data(static_cast<int>(capacity));
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = m_data[(m_begin + m_size - size + i) % m_size];
+        }
+        m_data = data;
+        m_begin = 0;
+        m_size = size;
+    }
+
     class ConstIterator
     {
         QPointer<StringRingBuffer> m_buffer;
@@ -101,6 +140,11 @@ public:
             return *this;
         }
 
+        quint64 getId() const
+        {
+            return m_buffer->getFirstId() + m_index;
+        }
+
         const QString& operator*()
         {
             const size_t currentIndex = (m_buffer->m_begin + m_index) % m_buffer->m_size;
@@ -0,0 +1,142 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TextSearch.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static inline ushort foldAscii(const ushort c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<ushort>(c | 0x20) : c;
+}
+
+static inline bool equalsIgnoringAsciiCase(const ushort* text, const ushort* term, const int length)
+{
+    for (int i = 0; i < length; ++i)
+    {
+        if (foldAscii(text[i]) != foldAscii(term[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef __SSE2__
+static inline __m128i foldAscii(const __m128i chars)
+{
+    // the comparisons are signed, so the characters above 0x7fff are never folded either
+    const __m128i upper = _mm_and_si128(
+        _mm_cmpgt_epi16(chars, _mm_set1_epi16('A' - 1)),
+        _mm_cmplt_epi16(chars, _mm_set1_epi16('Z' + 1))
+    );
+    return _mm_or_si128(chars, _mm_and_si128(upper, _mm_set1_epi16(0x20)));
+}
+#endif
+
+bool TextSearch::isAscii(const QChar* text, const int length)
+{
+    const ushort* const chars = reinterpret_cast<const ushort*>(text);
+    int i = 0;
+
+#ifdef __SSE2__
+    __m128i bits = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8)
+    {
+        bits = _mm_or_si128(bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i)));
+    }
+
+    const __m128i nonAscii = _mm_and_si128(bits, _mm_set1_epi16(static_cast<short>(0xff80)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) != 0xffff)
+    {
+        return false;
+    }
+#endif
+
+    ushort tailBits = 0;
+    for (; i < length; ++i)
+    {
+        tailBits |= chars[i];
+    }
+    return tailBits < 0x80;
+}
+
+int TextSearch::indexOfIgnoringAsciiCase(const QChar* text, const int length, const QChar* term, const int termLength)
+{
+    if (termLength == 0)
+    {
+        return 0;
+    }
+
+    const ushort* const chars = reinterpret_cast<const ushort*>(text);
+    const ushort* const termChars = reinterpret_cast<const ushort*>(term);
+    const ushort first = foldAscii(termChars[0]);
+    const ushort last = foldAscii(termChars[termLength - 1]);
+    const int endPosition = length - termLength + 1;
+    int i = 0;
+
+#ifdef __SSE2__
+    // 8 positions are checked at once by comparing their first and last characters,
+    // only the positions where both of them match are compared entirely
+    const __m128i firstChars = _mm_set1_epi16(static_cast<short>(first));
+    const __m128i lastChars = _mm_set1_epi16(static_cast<short>(last));
+    for (; i + 8 <= endPosition; i += 8)
+    {
+        const __m128i firstBlock = foldAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i)));
+        const __m128i lastBlock = foldAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i + termLength - 1)));
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(firstBlock, firstChars), _mm_cmpeq_epi16(lastBlock, lastChars)));
+        for (int lane = 0; mask != 0; ++lane, mask >>= 2)
+        {
+            if ((mask & 1) != 0 && equalsIgnoringAsciiCase(chars + i + lane + 1, termChars + 1, termLength - 2))
+            {
+                return i + lane;
+            }
+        }
+    }
+#endif
+
+    for (; i < endPosition; ++i)
+    {
+        if (foldAscii(chars[i]) == first &&
+            foldAscii(chars[i + termLength - 1]) == last &&
+            equalsIgnoringAsciiCase(chars + i + 1, termChars + 1, termLength - 2))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool TextSearch::contains(const QStringRef& text, const QStringRef& term, const Qt::CaseSensitivity cs)
+{
+    if (cs == Qt::CaseSensitive)
+    {
+        return text.contains(term);
+    }
+
+    // some non-ASCII characters fold to ASCII ones, like the Kelvin sign to k
+    if (isAscii(term.unicode(), term.length()) && isAscii(text.unicode(), text.length()))
+    {
+        return indexOfIgnoringAsciiCase(text.unicode(), text.length(), term.unicode(), term.length()) >= 0;
+    }
+    else
+    {
+        return text.contains(term, Qt::CaseInsensitive);
+    }
+}
@@ -0,0 +1,36 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEXTSEARCH_H
+#define TEXTSEARCH_H
+
+#include <QChar>
+#include <QStringRef>
+
+namespace TextSearch
+{
+    bool isAscii(const QChar* text, const int length);
+
+    // only A-Z and a-z are folded, returns -1 if the term is not found
+    int indexOfIgnoringAsciiCase(const QChar* text, const int length, const QChar* term, const int termLength);
+
+    // case insensitive search of ASCII terms in ASCII text is vectorized,
+    // anything else goes through the Unicode case folding of Qt
+    bool contains(const QStringRef& text, const QStringRef& term, const Qt::CaseSensitivity cs);
+}
+
+#endif // TEXTSEARCH_H
@@ -0,0 +1,238 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TrigramIndex.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+// approximate cost of a QHash node with an empty QByteArray
+static const size_t POSTING_LIST_OVERHEAD = 64;
+
+TrigramIndex::TrigramIndex(const size_t memoryBudget)
+    : m_firstBlock(0)
+    , m_endBlock(0)
+    , m_compactedFirstBlock(0)
+    , m_memoryBudget(memoryBudget)
+    , m_memoryUsage(0)
+{
+}
+
+quint64 TrigramIndex::trigramAt(const QChar* text)
+{
+    return (quint64(text[0].unicode()) << 32) | (quint64(text[1].unicode()) << 16) | quint64(text[2].unicode());
+}
+
+QVector<quint64> TrigramIndex::extractTrigrams(const QVector<Text>& texts)
+{
+    QVector<quint64> trigrams;
+    for (const Text& text : texts)
+    {
+        const QChar* const data = text.line.constData() + text.position;
+        for (int i = 0; i + TRIGRAM_LENGTH <= text.length; ++i)
+        {
+            trigrams.append(trigramAt(data + i));
+        }
+    }
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void TrigramIndex::addBlock(const quint64 block, const QVector<quint64>& trigrams)
+{
+    if (block < m_firstBlock)
+    {
+        // evicted while it was being processed
+        return;
+    }
+
+    if (block != m_endBlock)
+    {
+        // a block is missing, so the index can't tell anything about it
+        qDebug() << "TrigramIndex: expected block" << m_endBlock << "got" << block << "; starting over";
+        m_postings.clear();
+        m_memoryUsage = 0;
+        m_firstBlock = block;
+        m_compactedFirstBlock = block;
+    }
+
+    for (const quint64 trigram : trigrams)
+    {
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end())
+        {
+            it = m_postings.insert(trigram, PostingList());
+            it->lastBlock = 0;
+            it->size = 0;
+            m_memoryUsage += POSTING_LIST_OVERHEAD;
+        }
+
+        const int oldSize = it->deltas.size();
+        appendVarint(it->deltas, it->size == 0 ? block : block - it->lastBlock);
+        it->lastBlock = block;
+        ++it->size;
+        m_memoryUsage += static_cast<size_t>(it->deltas.size() - oldSize);
+    }
+
+    m_endBlock = block + 1;
+
+    while (m_memoryUsage > m_memoryBudget && m_firstBlock < m_endBlock)
+    {
+        // keep the latest half of the indexed blocks
+        m_firstBlock += qMax(quint64(1), (m_endBlock - m_firstBlock) / 2);
+        qDebug() << "TrigramIndex: memory budget exceeded; dropping blocks before" << m_firstBlock;
+        compact();
+    }
+}
+
+void TrigramIndex::evict(const quint64 firstId)
+{
+    const quint64 firstLiveBlock = firstId / BLOCK_SIZE;
+    if (firstLiveBlock <= m_firstBlock)
+    {
+        return;
+    }
+
+    m_firstBlock = firstLiveBlock;
+    if (m_firstBlock >= m_endBlock)
+    {
+        m_postings.clear();
+        m_memoryUsage = 0;
+        m_endBlock = m_firstBlock;
+        m_compactedFirstBlock = m_firstBlock;
+    }
+    else if (m_firstBlock - m_compactedFirstBlock >= m_endBlock - m_firstBlock)
+    {
+        // dead blocks take as much room as live ones
+        compact();
+    }
+}
+
+void TrigramIndex::compact()
+{
+    m_memoryUsage = 0;
+    for (auto it = m_postings.begin(); it != m_postings.end();)
+    {
+        const QVector<quint64> blocks = decode(*it, m_firstBlock);
+        if (blocks.isEmpty())
+        {
+            it = m_postings.erase(it);
+            continue;
+        }
+
+        it->deltas.clear();
+        quint64 previous = 0;
+        for (const quint64 block : blocks)
+        {
+            appendVarint(it->deltas, block - previous);
+            previous = block;
+        }
+        it->deltas.squeeze();
+        it->lastBlock = previous;
+        it->size = blocks.size();
+
+        m_memoryUsage += POSTING_LIST_OVERHEAD + static_cast<size_t>(it->deltas.size());
+        ++it;
+    }
+
+    m_compactedFirstBlock = m_firstBlock;
+}
+
+bool TrigramIndex::findCandidateBlocks(const QStringRef& term, QVector<quint64>& blocks) const
+{
+    blocks.clear();
+    if (term.length() < TRIGRAM_LENGTH)
+    {
+        return false;
+    }
+
+    QVector<const PostingList*> postingLists;
+    for (int i = 0; i + TRIGRAM_LENGTH <= term.length(); ++i)
+    {
+        const auto it = m_postings.constFind(trigramAt(term.unicode() + i));
+        if (it == m_postings.constEnd())
+        {
+            return true;
+        }
+        postingLists.append(&(*it));
+    }
+
+    // the rarest trigram goes first, it bounds the result
+    std::sort(postingLists.begin(), postingLists.end(), [](const PostingList* a, const PostingList* b) {
+        return a->size < b->size;
+    });
+
+    blocks = decode(*postingLists.first(), m_firstBlock);
+    for (int i = 1; i < postingLists.size() && !blocks.isEmpty(); ++i)
+    {
+        const QVector<quint64> other = decode(*postingLists[i], m_firstBlock);
+        QVector<quint64> intersection(qMin(blocks.size(), other.size()));
+        const auto end = std::set_intersection(
+            blocks.constBegin(), blocks.constEnd(),
+            other.constBegin(), other.constEnd(),
+            intersection.begin()
+        );
+        intersection.resize(static_cast<int>(end - intersection.begin()));
+        blocks = intersection;
+    }
+
+    return true;
+}
+
+void TrigramIndex::appendVarint(QByteArray& bytes, quint64 value)
+{
+    while (value >= 0x80)
+    {
+        bytes.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.append(static_cast<char>(value));
+}
+
+QVector<quint64> TrigramIndex::decode(const PostingList& postingList, const quint64 firstBlock)
+{
+    QVector<quint64> blocks;
+    blocks.reserve(postingList.size);
+
+    quint64 block = 0;
+    quint64 delta = 0;
+    int shift = 0;
+    for (const char c : postingList.deltas)
+    {
+        const quint64 byte = static_cast<quint8>(c);
+        delta |= (byte & 0x7F) << shift;
+        if (byte & 0x80)
+        {
+            shift += 7;
+        }
+        else
+        {
+            block += delta;
+            if (block >= firstBlock)
+            {
+                blocks.append(block);
+            }
+            delta = 0;
+            shift = 0;
+        }
+    }
+
+    return blocks;
+}
@@ -0,0 +1,80 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+// Maps every trigram of the indexed text to the blocks of BLOCK_SIZE records containing it.
+// Block ids are kept as delta encoded varints, blocks are indexed in ascending order only.
+class TrigramIndex
+{
+public:
+    static const int BLOCK_SIZE = 256;
+    static const int TRIGRAM_LENGTH = 3;
+
+    struct Text
+    {
+        QString line;
+        int position;
+        int length;
+    };
+
+private:
+    struct PostingList
+    {
+        QByteArray deltas;
+        quint64 lastBlock;
+        int size;
+    };
+
+    QHash<quint64, PostingList> m_postings;
+    quint64 m_firstBlock;
+    quint64 m_endBlock;
+    quint64 m_compactedFirstBlock;
+    size_t m_memoryBudget;
+    size_t m_memoryUsage;
+
+public:
+    explicit TrigramIndex(const size_t memoryBudget);
+
+    static QVector<quint64> extractTrigrams(const QVector<Text>& texts);
+
+    void addBlock(const quint64 block, const QVector<quint64>& trigrams);
+    void evict(const quint64 firstId);
+
+    // returns false if the term can't be looked up; otherwise candidate blocks are
+    // sorted ids of indexed blocks which may contain the term
+    bool findCandidateBlocks(const QStringRef& term, QVector<quint64>& blocks) const;
+
+    inline quint64 getFirstBlock() const { return m_firstBlock; }
+    inline quint64 getEndBlock() const { return m_endBlock; }
+    inline size_t getMemoryUsage() const { return m_memoryUsage; }
+
+private:
+    void compact();
+    static quint64 trigramAt(const QChar* text);
+    static void appendVarint(QByteArray& bytes, quint64 value);
+    static QVector<quint64> decode(const PostingList& postingList, const quint64 firstBlock);
+};
+
+#endif // TRIGRAMINDEX_H
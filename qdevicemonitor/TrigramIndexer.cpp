@@ -0,0 +1,131 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TrigramIndexer.h"
+
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+
+TrigramIndexer::TrigramIndexer(const size_t memoryBudget)
+    : m_index(memoryBudget)
+    , m_pendingBlock(0)
+    , m_pendingRecords(-1)
+    , m_processingBlock(0)
+{
+    connect(&m_watcher, &QFutureWatcher<QVector<quint64>>::finished, this, &TrigramIndexer::onBlockProcessed);
+}
+
+TrigramIndexer::~TrigramIndexer()
+{
+    disconnect(&m_watcher, nullptr, this, nullptr);
+    m_watcher.waitForFinished();
+}
+
+void TrigramIndexer::add(const quint64 id, const QString& line, const QStringRef& text)
+{
+    const quint64 block = id / TrigramIndex::BLOCK_SIZE;
+    const int offset = static_cast<int>(id % TrigramIndex::BLOCK_SIZE);
+    if (offset == 0)
+    {
+        m_pendingBlock = block;
+        m_pendingRecords = 0;
+        m_pendingTexts.clear();
+    }
+    else if (block != m_pendingBlock || offset != m_pendingRecords)
+    {
+        // started in the middle of a block, wait for the next one
+        return;
+    }
+
+    ++m_pendingRecords;
+    if (!text.isEmpty())
+    {
+        m_pendingTexts.append({ line, text.position(), text.length() });
+    }
+
+    if (m_pendingRecords == TrigramIndex::BLOCK_SIZE)
+    {
+        m_blocks.enqueue(Block(m_pendingBlock, m_pendingTexts));
+        m_pendingTexts.clear();
+        m_pendingRecords = -1;
+        processNextBlock();
+    }
+}
+
+void TrigramIndexer::evict(const quint64 firstId)
+{
+    while (!m_blocks.isEmpty() && (m_blocks.head().first + 1) * TrigramIndex::BLOCK_SIZE <= firstId)
+    {
+        m_blocks.dequeue();
+    }
+    m_index.evict(firstId);
+}
+
+bool TrigramIndexer::findCandidates(const QStringRef& term, const quint64 firstId, const quint64 endId, QVector<RecordIdRange>& ranges) const
+{
+    QVector<quint64> blocks;
+    if (!m_index.findCandidateBlocks(term, blocks))
+    {
+        return false;
+    }
+
+    const quint64 indexedBegin = qMin(endId, qMax(firstId, m_index.getFirstBlock() * TrigramIndex::BLOCK_SIZE));
+    const quint64 indexedEnd = qMax(indexedBegin, qMin(endId, m_index.getEndBlock() * TrigramIndex::BLOCK_SIZE));
+
+    ranges.clear();
+    if (firstId < indexedBegin)
+    {
+        RecordIdRange::append(ranges, firstId, indexedBegin);
+    }
+
+    for (const quint64 block : blocks)
+    {
+        const quint64 blockBegin = qMax(indexedBegin, block * TrigramIndex::BLOCK_SIZE);
+        const quint64 blockEnd = qMin(indexedEnd, (block + 1) * TrigramIndex::BLOCK_SIZE);
+        if (blockBegin < blockEnd)
+        {
+            RecordIdRange::append(ranges, blockBegin, blockEnd);
+        }
+    }
+
+    if (indexedEnd < endId)
+    {
+        RecordIdRange::append(ranges, indexedEnd, endId);
+    }
+
+    qDebug() << "TrigramIndexer::findCandidates" << term << ";" << blocks.size() << "blocks;"
+             << ranges.size() << "ranges of" << (endId - firstId) << "lines";
+    return true;
+}
+
+void TrigramIndexer::onBlockProcessed()
+{
+    m_index.addBlock(m_processingBlock, m_watcher.result());
+    processNextBlock();
+}
+
+void TrigramIndexer::processNextBlock()
+{
+    if (m_watcher.isRunning() || m_blocks.isEmpty())
+    {
+        return;
+    }
+
+    const Block block = m_blocks.dequeue();
+    m_processingBlock = block.first;
+    m_watcher.setFuture(QtConcurrent::run(&TrigramIndex::extractTrigrams, block.second));
+}
@@ -0,0 +1,64 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRIGRAMINDEXER_H
+#define TRIGRAMINDEXER_H
+
+#include "RecordIdList.h"
+#include "TrigramIndex.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QPair>
+#include <QQueue>
+#include <QStringRef>
+#include <QVector>
+
+// Feeds a TrigramIndex with complete blocks of records.
+// Trigrams are extracted in a background thread, one block at a time;
+// records which aren't indexed yet are always reported as candidates.
+class TrigramIndexer : public QObject
+{
+    Q_OBJECT
+
+    typedef QPair<quint64, QVector<TrigramIndex::Text>> Block;
+
+    TrigramIndex m_index;
+    QVector<TrigramIndex::Text> m_pendingTexts;
+    quint64 m_pendingBlock;
+    int m_pendingRecords;
+    QQueue<Block> m_blocks;
+    quint64 m_processingBlock;
+    QFutureWatcher<QVector<quint64>> m_watcher;
+
+public:
+    explicit TrigramIndexer(const size_t memoryBudget);
+    ~TrigramIndexer() override;
+
+    void add(const quint64 id, const QString& line, const QStringRef& text);
+    void evict(const quint64 firstId);
+    // the candidates are ranges of ids, which aren't expanded on the GUI thread
+    bool findCandidates(const QStringRef& term, const quint64 firstId, const quint64 endId, QVector<RecordIdRange>& ranges) const;
+
+private slots:
+    void onBlockProcessed();
+
+private:
+    void processNextBlock();
+};
+
+#endif // TRIGRAMINDEXER_H
@@ -0,0 +1,77 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef VALUECOLUMN_H
+#define VALUECOLUMN_H
+
+#include "RecordIdList.h"
+
+#include <QVector>
+
+// Values of the records, addressed by slot like the log buffer.
+// They're stored in chunks, so a copy held by a worker thread costs the
+// next write only one chunk instead of the whole column.
+class ValueColumn
+{
+public:
+    static const int CHUNK_SIZE = 4096;
+
+private:
+    QVector<QVector<qint64>> m_chunks;
+    int m_capacity;
+
+public:
+    explicit ValueColumn(const int capacity = 1, const qint64 value = 0)
+        : m_capacity(capacity)
+    {
+        for (int slot = 0; slot < capacity; slot += CHUNK_SIZE)
+        {
+            m_chunks.append(QVector<qint64>(qMin(capacity - slot, static_cast<int>(CHUNK_SIZE)), value));
+        }
+    }
+
+    inline int getCapacity() const { return m_capacity; }
+    inline qint64 at(const int slot) const { return m_chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE]; }
+    inline void set(const int slot, const qint64 value) { m_chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE] = value; }
+
+    // the ranges are the ids of the records, which live in the slots id % capacity
+    RecordIdList getIdsInRange(const qint64 min, const qint64 max, const QVector<RecordIdRange>& ranges) const
+    {
+        const quint64 capacity = static_cast<quint64>(m_capacity);
+        RecordIdList ids;
+        for (const RecordIdRange& range : ranges)
+        {
+            // every chunk is scanned linearly
+            for (quint64 id = range.begin; id < range.end;)
+            {
+                const int slot = static_cast<int>(id % capacity);
+                const int slots = static_cast<int>(qMin(range.end - id, static_cast<quint64>(qMin(m_capacity - slot, CHUNK_SIZE - slot % CHUNK_SIZE))));
+                const qint64* const data = m_chunks[slot / CHUNK_SIZE].constData() + slot % CHUNK_SIZE;
+                for (int i = 0; i < slots; ++i)
+                {
+                    if (data[i] >= min && data[i] <= max)
+                    {
+                        ids.append(id + i);
+                    }
+                }
+                id += slots;
+            }
+        }
+        return ids;
+    }
+};
+
+#endif // VALUECOLUMN_H
@@ -0,0 +1,313 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ValueFilter.h"
+
+#include <limits>
+
+typedef bool (*ValueParser)(const QStringRef& text, qint64& value, qint64& precision);
+
+static const qint64 MAX_VALUE = std::numeric_limits<qint64>::max();
+static const int MAX_INTEGER_DIGITS = 18;
+
+static inline bool isDigit(const QChar c)
+{
+    return c >= QLatin1Char('0') && c <= QLatin1Char('9');
+}
+
+static inline int digitValue(const QChar c)
+{
+    return c.unicode() - '0';
+}
+
+static bool parseInteger(const QStringRef& text, qint64& value, qint64& precision)
+{
+    if (text.isEmpty() || text.length() > MAX_INTEGER_DIGITS)
+    {
+        return false;
+    }
+
+    qint64 result = 0;
+    for (int i = 0; i < text.length(); ++i)
+    {
+        if (!isDigit(text.at(i)))
+        {
+            return false;
+        }
+        result = result * 10 + digitValue(text.at(i));
+    }
+
+    value = result;
+    precision = 1;
+    return true;
+}
+
+static bool parseRange(const QStringRef& text, const ValueParser parseValue, const bool bareValueIsRange, qint64& min, qint64& max)
+{
+    qint64 value = 0;
+    qint64 precision = 0;
+    if (text.startsWith(QLatin1String(">=")))
+    {
+        if (!parseValue(text.mid(2), value, precision))
+        {
+            return false;
+        }
+        min = value;
+        max = MAX_VALUE;
+    }
+    else if (text.startsWith(QLatin1String("<=")))
+    {
+        if (!parseValue(text.mid(2), value, precision))
+        {
+            return false;
+        }
+        min = 0;
+        max = value + precision - 1;
+    }
+    else if (text.startsWith(QLatin1Char('>')))
+    {
+        if (!parseValue(text.mid(1), value, precision))
+        {
+            return false;
+        }
+        min = value + precision;
+        max = MAX_VALUE;
+    }
+    else if (text.startsWith(QLatin1Char('<')))
+    {
+        if (!parseValue(text.mid(1), value, precision))
+        {
+            return false;
+        }
+        min = 0;
+        max = value - 1;
+    }
+    else if (text.startsWith(QLatin1Char('=')))
+    {
+        if (!parseValue(text.mid(1), value, precision))
+        {
+            return false;
+        }
+        min = value;
+        max = value + precision - 1;
+    }
+    else
+    {
+        const int dash = text.indexOf(QLatin1Char('-'));
+        qint64 maxValue = 0;
+        qint64 maxPrecision = 0;
+        if (dash > 0)
+        {
+            if (!parseValue(text.left(dash), value, precision) || !parseValue(text.mid(dash + 1), maxValue, maxPrecision))
+            {
+                return false;
+            }
+            min = value;
+            max = maxValue + maxPrecision - 1;
+        }
+        else if (bareValueIsRange && parseValue(text, value, precision))
+        {
+            min = value;
+            max = value + precision - 1;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool parseDuration(const QStringRef& text, qint64& msecs)
+{
+    const QStringRef duration = text.startsWith(QLatin1Char('-')) ? text.mid(1) : text;
+    if (duration.length() < 2)
+    {
+        return false;
+    }
+
+    qint64 unit = 0;
+    switch (duration.at(duration.length() - 1).toLatin1())
+    {
+    case 's':
+        unit = 1000;
+        break;
+    case 'm':
+        unit = 60 * 1000;
+        break;
+    case 'h':
+        unit = 60 * 60 * 1000;
+        break;
+    case 'd':
+        unit = RecordFields::MSECS_PER_DAY;
+        break;
+    default:
+        return false;
+    }
+
+    qint64 value = 0;
+    qint64 precision = 0;
+    if (!parseInteger(duration.left(duration.length() - 1), value, precision) || value > MAX_VALUE / unit)
+    {
+        return false;
+    }
+
+    msecs = value * unit;
+    return true;
+}
+
+ValueFilter::ValueFilter()
+    : m_valid(false)
+    , m_value(RecordFields::PidValue)
+    , m_min(0)
+    , m_max(-1)
+{
+}
+
+ValueFilter ValueFilter::parse(const QString& filter, const QDateTime& now)
+{
+    ValueFilter result;
+
+    const int colon = filter.indexOf(':');
+    if (colon <= 0)
+    {
+        return result;
+    }
+
+    const QStringRef column = filter.leftRef(colon + 1);
+    const QStringRef text = filter.midRef(colon + 1);
+    if (column == QLatin1String("pid:") || column == QLatin1String("tid:"))
+    {
+        result.m_value = column == QLatin1String("pid:") ? RecordFields::PidValue : RecordFields::TidValue;
+        result.m_valid = parseRange(text, parseInteger, false, result.m_min, result.m_max);
+    }
+    else if (column == QLatin1String("time:"))
+    {
+        result.m_value = RecordFields::TimeValue;
+        result.m_valid = parseRange(text, ValueFilter::parseTime, true, result.m_min, result.m_max);
+    }
+    else if (column == QLatin1String("since:"))
+    {
+        qint64 msecs = 0;
+        if (parseDuration(text, msecs))
+        {
+            const QDateTime since = now.addMSecs(-msecs);
+            result.m_value = RecordFields::TimestampValue;
+            result.m_min = RecordFields::makeTimestamp(since.date().month(), since.date().day(), since.time().msecsSinceStartOfDay());
+            result.m_max = MAX_VALUE;
+            result.m_valid = true;
+        }
+    }
+
+    return result;
+}
+
+bool ValueFilter::parseTime(const QStringRef& text, qint64& msecs, qint64& precision)
+{
+    static const qint64 units[] = { 60 * 60 * 1000, 60 * 1000, 1000 };
+    static const int unitsCount = sizeof(units) / sizeof(units[0]);
+
+    const int length = text.length();
+    int position = 0;
+    qint64 result = 0;
+    qint64 resultPrecision = 0;
+    for (int part = 0; part < unitsCount; ++part)
+    {
+        if (part > 0)
+        {
+            if (position >= length)
+            {
+                break;
+            }
+            else if (text.at(position) != QLatin1Char(':'))
+            {
+                return false;
+            }
+            ++position;
+        }
+
+        const int start = position;
+        int value = 0;
+        while (position < length && position - start < 2 && isDigit(text.at(position)))
+        {
+            value = value * 10 + digitValue(text.at(position));
+            ++position;
+        }
+
+        if (position == start)
+        {
+            return false;
+        }
+
+        result += value * units[part];
+        resultPrecision = units[part];
+    }
+
+    if (resultPrecision == units[0])
+    {
+        // a bare number is too ambiguous for a time
+        return false;
+    }
+
+    if (position < length && text.at(position) == QLatin1Char('.') && resultPrecision == units[unitsCount - 1])
+    {
+        ++position;
+        const int start = position;
+        int value = 0;
+        while (position < length && position - start < 3 && isDigit(text.at(position)))
+        {
+            value = value * 10 + digitValue(text.at(position));
+            ++position;
+        }
+
+        if (position == start)
+        {
+            return false;
+        }
+
+        resultPrecision = 1;
+        for (int digits = position - start; digits < 3; ++digits)
+        {
+            value *= 10;
+            resultPrecision *= 10;
+        }
+        result += value;
+    }
+
+    if (position != length)
+    {
+        return false;
+    }
+
+    msecs = result;
+    precision = resultPrecision;
+    return true;
+}
+
+bool ValueFilter::parseDate(const QStringRef& text, int& month, int& day)
+{
+    if (text.length() != 5 || text.at(2) != QLatin1Char('-') ||
+        !isDigit(text.at(0)) || !isDigit(text.at(1)) || !isDigit(text.at(3)) || !isDigit(text.at(4)))
+    {
+        return false;
+    }
+
+    month = digitValue(text.at(0)) * 10 + digitValue(text.at(1));
+    day = digitValue(text.at(3)) * 10 + digitValue(text.at(4));
+    return true;
+}
@@ -0,0 +1,60 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VALUEFILTER_H
+#define VALUEFILTER_H
+
+#include "RecordIndex.h"
+
+#include <QDateTime>
+#include <QString>
+#include <QStringRef>
+
+// Typed filter term which is evaluated on the integer values of RecordFields:
+// pid:1200-1300, tid:=4567, pid:>100, time:>12:03:00, time:12:03, since:-5m.
+// A plain number like pid:12 isn't typed, it's still matched as a substring.
+class ValueFilter
+{
+    bool m_valid;
+    RecordFields::Value m_value;
+    qint64 m_min;
+    qint64 m_max;
+
+public:
+    ValueFilter();
+
+    inline bool isValid() const { return m_valid; }
+    inline RecordFields::Value getValue() const { return m_value; }
+    inline qint64 getMin() const { return m_min; }
+    inline qint64 getMax() const { return m_max; }
+
+    inline bool matches(const RecordFields& fields) const
+    {
+        const qint64 value = fields.values[m_value];
+        return value >= m_min && value <= m_max;
+    }
+
+    static ValueFilter parse(const QString& filter, const QDateTime& now = QDateTime::currentDateTime());
+
+    // HH:MM[:SS[.mmm]]; precision is the duration covered by the least significant part
+    static bool parseTime(const QStringRef& text, qint64& msecs, qint64& precision);
+
+    // MM-DD
+    static bool parseDate(const QStringRef& text, int& month, int& day);
+};
+
+#endif // VALUEFILTER_H
@@ -198,8 +198,7 @@ void AndroidDevice::stopLogProcess()
 
 void AndroidDevice::onUpdateFilter(const QString& filter)
 {
-    m_filters = filter.split(' ');
-    m_filtersValid = true;
+    setFilters(filter);
     reloadTextEdit();
     maybeAddCompletionAfterDelay(filter);
 }
@@ -219,61 +218,135 @@ void AndroidDevice::onLogProcessStatusChange(const QProcess::ProcessState newSta
     }
 }
 
-void AndroidDevice::filterAndAddToTextEdit(const QString& line)
+void AndroidDevice::parseLine(const QString& line, RecordFields& fields) const
 {
     static const QRegularExpression re(
         "(?<date>[\\d-]+) *(?<time>[\\d:\\.]+) *(?<pid>\\d+) *(?<tid>\\d+) *(?<verbosity>[A-Z]) *(?<tag>.+):",
         QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption
     );
 
-    bool filtersMatch = true;
     const QRegularExpressionMatch match = re.match(line);
     if (match.hasMatch())
     {
+        const QStringRef verbosity = match.capturedRef("verbosity");
+        const int verbosityLevel = Utils::verbosityCharacterToInt(verbosity.at(0).toLatin1());
+        fields.verbosity = static_cast<VerbosityEnum>(qMax(verbosityLevel, static_cast<int>(Assert)));
+
         const QStringRef date = match.capturedRef("date");
         const QStringRef time = match.capturedRef("time");
         const QStringRef pid = match.capturedRef("pid");
         const QStringRef tid = match.capturedRef("tid");
-        const QStringRef verbosity = match.capturedRef("verbosity");
-        const QStringRef tag = match.capturedRef("tag").trimmed();
-        const QStringRef text = line.midRef(match.capturedEnd("tag") + 1);
 
-        const auto verbosityLevel = static_cast<VerbosityEnum>(Utils::verbosityCharacterToInt(verbosity.at(0).toLatin1()));
+        fields.setColumn(VerbosityColumn, verbosity);
+        fields.setColumn(DateColumn, date);
+        fields.setColumn(TimeColumn, time);
+        fields.setColumn(PidColumn, pid);
+        fields.setColumn(TidColumn, tid);
+        fields.setColumn(TagColumn, match.capturedRef("tag").trimmed());
+        fields.setColumn(TextColumn, line.midRef(match.capturedEnd("tag") + 1));
+
+        bool ok = false;
+        const qint64 pidValue = pid.toLongLong(&ok);
+        if (ok)
+        {
+            fields.values[RecordFields::PidValue] = pidValue;
+        }
 
-        checkFilters(filtersMatch, m_filtersValid, verbosityLevel, pid, tid, tag, text);
+        const qint64 tidValue = tid.toLongLong(&ok);
+        if (ok)
+        {
+            fields.values[RecordFields::TidValue] = tidValue;
+        }
 
-        if (filtersMatch)
+        qint64 msecs = 0;
+        qint64 precision = 0;
+        if (ValueFilter::parseTime(time, msecs, precision))
         {
-            const auto verbosityColorType = static_cast<ColorTheme::ColorType>(verbosityLevel);
-            m_deviceWidget->addText(verbosityColorType, verbosity);
-            m_deviceWidget->addText(ColorTheme::DateTime, date);
-            m_deviceWidget->addText(ColorTheme::DateTime, time);
-            m_deviceWidget->addText(ColorTheme::Pid, pid);
-            m_deviceWidget->addText(ColorTheme::Tid, tid);
-            m_deviceWidget->addText(ColorTheme::Tag, tag);
-            m_deviceWidget->addText(verbosityColorType, text);
-            m_deviceWidget->flushText();
+            fields.values[RecordFields::TimeValue] = msecs;
+
+            int month = 0;
+            int day = 0;
+            if (ValueFilter::parseDate(date, month, day))
+            {
+                fields.values[RecordFields::TimestampValue] = RecordFields::makeTimestamp(month, day, msecs);
+            }
         }
     }
     else
     {
         qDebug() << "failed to parse" << line;
-        checkFilters(filtersMatch, m_filtersValid);
-        if (filtersMatch)
-        {
-            m_deviceWidget->addText(ColorTheme::VerbosityVerbose, QStringRef(&line));
-            m_deviceWidget->flushText();
-        }
     }
+}
 
-    m_deviceWidget->highlightFilterLineEdit(!m_filtersValid);
+bool AndroidDevice::matchesFilters(const QString& line, const RecordFields& fields)
+{
+    bool filtersMatch = true;
+    if (fields.isParsed())
+    {
+        checkFilters(
+            filtersMatch,
+            m_filtersValid,
+            fields,
+            fields.getColumn(line, PidColumn),
+            fields.getColumn(line, TidColumn),
+            fields.getColumn(line, TagColumn),
+            fields.getColumn(line, TextColumn)
+        );
+    }
+    else
+    {
+        checkFilters(filtersMatch, m_filtersValid, fields);
+    }
+    return filtersMatch;
 }
 
-void AndroidDevice::checkFilters(bool& filtersMatch, bool& filtersValid, const VerbosityEnum verbosityLevel, const QStringRef& pid, const QStringRef& tid, const QStringRef& tag, const QStringRef& text)
+void AndroidDevice::formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const
 {
-    filtersMatch = verbosityLevel <= m_deviceWidget->getVerbosityLevel();
+    if (fields.isParsed())
+    {
+        const auto verbosityColorType = static_cast<ColorTheme::ColorType>(fields.verbosity);
+        logLine.append(verbosityColorType, fields.getColumn(line, VerbosityColumn));
+        logLine.append(ColorTheme::DateTime, fields.getColumn(line, DateColumn));
+        logLine.append(ColorTheme::DateTime, fields.getColumn(line, TimeColumn));
+        logLine.append(ColorTheme::Pid, fields.getColumn(line, PidColumn));
+        logLine.append(ColorTheme::Tid, fields.getColumn(line, TidColumn));
+        logLine.append(ColorTheme::Tag, fields.getColumn(line, TagColumn));
+        logLine.append(verbosityColorType, fields.getColumn(line, TextColumn));
+    }
+    else
+    {
+        logLine.append(ColorTheme::VerbosityVerbose, QStringRef(&line));
+    }
+}
 
-    if (!filtersMatch || !filtersValid)
+int AndroidDevice::getKeyColumn(const RecordIndex::Key key) const
+{
+    switch (key)
+    {
+    case RecordIndex::TagKey:
+        return TagColumn;
+    case RecordIndex::PidKey:
+        return PidColumn;
+    default:
+        return -1;
+    }
+}
+
+bool AndroidDevice::hasValue(const RecordFields::Value value) const
+{
+    (void) value;
+    return true;
+}
+
+QStringRef AndroidDevice::getSearchableText(const QString& line, const RecordFields& fields) const
+{
+    // unparsed lines have no text column, so no text filter can match them
+    return fields.isParsed() ? fields.getColumn(line, TextColumn) : QStringRef();
+}
+
+void AndroidDevice::checkFilters(bool& filtersMatch, bool& filtersValid, const RecordFields& fields, const QStringRef& pid, const QStringRef& tid, const QStringRef& tag, const QStringRef& text)
+{
+    if (!filtersValid)
     {
         return;
     }
@@ -281,9 +354,20 @@ void AndroidDevice::checkFilters(bool& filtersMatch, bool& filtersValid, const V
     QString textString;
     bool textStringInitialized = false;
 
-    for (auto it = m_filters.constBegin(); it != m_filters.constEnd(); ++it)
+    for (int i = 0; i < m_filters.size(); ++i)
     {
-        const QStringRef filter(&(*it));
+        const ValueFilter& valueFilter = m_valueFilters[i];
+        if (valueFilter.isValid())
+        {
+            if (!valueFilter.matches(fields))
+            {
+                filtersMatch = false;
+                break;
+            }
+            continue;
+        }
+
+        const QStringRef filter(&m_filters[i]);
         bool columnFound = false;
         if (!columnMatches("pid:", filter, pid, filtersValid, columnFound) ||
             !columnMatches("tid:", filter, tid, filtersValid, columnFound) ||
@@ -319,7 +403,7 @@ void AndroidDevice::reloadTextEdit()
     }
 
     qDebug() << "reloadTextEdit";
-    m_deviceWidget->clearTextEdit();
+    m_deviceWidget->clearLogView();
 
     updateLogBufferSpace();
     filterAndAddFromLogBufferToTextEdit();
@@ -367,7 +451,7 @@ void AndroidDevice::onLogReady()
     }
 
     QString line;
-    for (int i = 0; i < MAX_LINES_UPDATE && m_logProcess.canReadLine(); ++i)
+    for (int i = 0; i < getMaxLinesUpdate() && m_logProcess.canReadLine(); ++i)
     {
         m_tempStream << m_logProcess.readLine();
 #if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
@@ -379,7 +463,7 @@ void AndroidDevice::onLogReady()
 #endif
         {
             writeToLogFile(line);
-            filterAndAddToTextEdit(line);
+            filterAndAddLatestFromLogBufferToTextEdit();
         }
     }
 
@@ -30,6 +30,17 @@ class AndroidDevice : public BaseDevice
 {
     Q_OBJECT
 
+    enum Column
+    {
+        VerbosityColumn,
+        DateColumn,
+        TimeColumn,
+        PidColumn,
+        TidColumn,
+        TagColumn,
+        TextColumn
+    };
+
     QProcess m_infoProcess;
     QProcess m_logProcess;
     QProcess m_clearLogProcess;
@@ -52,7 +63,12 @@ public:
     void writeToLogFile(const QString& line) override;
 
     void onUpdateFilter(const QString& filter) override;
-    void filterAndAddToTextEdit(const QString& line) override;
+    void parseLine(const QString& line, RecordFields& fields) const override;
+    bool matchesFilters(const QString& line, const RecordFields& fields) override;
+    void formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const override;
+    int getKeyColumn(const RecordIndex::Key key) const override;
+    bool hasValue(const RecordFields::Value value) const override;
+    QStringRef getSearchableText(const QString& line, const RecordFields& fields) const override;
     const char* getPlatformName() const override { return "Android"; }
     void reloadTextEdit() override;
 
@@ -76,7 +92,7 @@ private:
 
     void checkFilters(bool& filtersMatch,
                       bool& filtersValid,
-                      const VerbosityEnum verbosityLevel = Verbose,
+                      const RecordFields& fields,
                       const QStringRef& pid = QStringRef(),
                       const QStringRef& tid = QStringRef(),
                       const QStringRef& tag = QStringRef(),
@@ -20,11 +20,18 @@
 #include "AndroidDevice.h"
 #include "IOSDevice.h"
 #include "TextFileDevice.h"
+#include "TextSearch.h"
 
+#include <QDateTime>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QIcon>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QStringBuilder>
 
+#include <algorithm>
+#include <functional>
+
 using namespace DataTypes;
 
 BaseDevice::BaseDevice(
@@ -44,6 +51,23 @@ BaseDevice::BaseDevice(
     , m_tabIndex(-1)
     , m_deviceFacade(deviceFacade)
     , m_filtersValid(true)
+    , m_caseSensitivity(Qt::CaseSensitive)
+    , m_matchedBeginId(0)
+    , m_matchedEndId(0)
+    , m_matchedCaseSensitivity(Qt::CaseSensitive)
+    , m_headCandidateCount(0)
+    , m_headCandidatesBeginId(0)
+    , m_restoredBeginId(0)
+    , m_restoredEndId(0)
+    , m_renderedBeginId(0)
+    , m_renderingSuspended(false)
+    , m_suspendedEndId(0)
+    , m_clearedEndId(0)
+    , m_matchCache(MATCH_CACHE_SIZE)
+    , m_readLines(0)
+    , m_findPending(false)
+    , m_findBackward(false)
+    , m_candidatesGeneration(0)
 {
     qDebug() << "new BaseDevice; type" << type << "; id" << id;
 
@@ -54,15 +78,34 @@ BaseDevice::BaseDevice(
 
     m_deviceWidget = QSharedPointer<DeviceWidget>::create(static_cast<QTabWidget*>(m_tabWidget), m_deviceFacade, id);
     m_deviceWidget->getFilterLineEdit().setCompleter(&m_deviceFacade->getFilterCompleter());
+    m_deviceWidget->getLogView().setSource(this);
     m_tabIndex = m_tabWidget->addTab(m_deviceWidget.data(), humanReadableName);
 
     m_completionAddTimer.setSingleShot(true);
     m_logReadyTimer.setSingleShot(true);
+    m_backfillTimer.setInterval(BACKFILL_INTERVAL);
+    m_releaseViewTimer.setSingleShot(true);
+    m_overloadTimer.setInterval(static_cast<int>(OverloadDetector::RATE_WINDOW));
+    m_overloadClock.start();
+    m_searchTimer.setInterval(BACKFILL_INTERVAL);
 
-    connect(&m_logReadyTimer, &QTimer::timeout, this, &BaseDevice::onLogReady);
+    connect(&m_logReadyTimer, &QTimer::timeout, this, &BaseDevice::readLog);
     connect(&m_completionAddTimer, &QTimer::timeout, this, &BaseDevice::addFilterAsCompletion);
+    connect(&m_backfillTimer, &QTimer::timeout, this, &BaseDevice::backfillTextEdit);
+    connect(&m_releaseViewTimer, &QTimer::timeout, this, &BaseDevice::releaseLogView);
+    connect(&m_overloadTimer, &QTimer::timeout, this, &BaseDevice::checkOverload);
+    connect(&m_searchTimer, &QTimer::timeout, this, &BaseDevice::searchOlderMatches);
+    connect(&m_candidatesWatcher, &QFutureWatcher<CandidateQuery::Result>::finished, this, &BaseDevice::onCandidatesCollected);
+    connect(m_deviceWidget.data(), &DeviceWidget::scrolledToTop, this, &BaseDevice::onScrolledToTop);
+    connect(m_deviceWidget.data(), &DeviceWidget::caseSensitivityChanged, this, &BaseDevice::updateCaseSensitivity);
+    connect(m_deviceWidget.data(), &DeviceWidget::highlightTermsChanged, this, &BaseDevice::updateSearchTerms);
+    connect(m_deviceWidget.data(), &DeviceWidget::findMatchRequested, this, &BaseDevice::findMatch);
+    connect(m_deviceWidget.data(), &DeviceWidget::clearLogRequested, this, &BaseDevice::clearLog);
     connect(&(m_deviceWidget->getFilterLineEdit()), &QLineEdit::textChanged, this, &BaseDevice::updateFilter);
-    connect(this, &BaseDevice::logReady, this, &BaseDevice::onLogReady);
+    connect(m_tabWidget.data(), &QTabWidget::currentChanged, this, &BaseDevice::onCurrentTabChanged);
+    connect(this, &BaseDevice::logReady, this, &BaseDevice::readLog);
+
+    setRenderingSuspended(m_tabWidget->currentWidget() != m_deviceWidget.data());
 }
 
 BaseDevice::~BaseDevice()
@@ -71,9 +114,25 @@ BaseDevice::~BaseDevice()
 
     disconnect(&m_logReadyTimer, nullptr, this, nullptr);
     disconnect(&m_completionAddTimer, nullptr, this, nullptr);
+    disconnect(&m_backfillTimer, nullptr, this, nullptr);
+    disconnect(&m_releaseViewTimer, nullptr, this, nullptr);
+    disconnect(&m_overloadTimer, nullptr, this, nullptr);
+    disconnect(&m_searchTimer, nullptr, this, nullptr);
+    disconnect(&m_candidatesWatcher, nullptr, this, nullptr);
+    m_candidatesWatcher.waitForFinished();
+    disconnect(m_deviceWidget.data(), &DeviceWidget::scrolledToTop, this, &BaseDevice::onScrolledToTop);
+    disconnect(m_deviceWidget.data(), &DeviceWidget::caseSensitivityChanged, this, &BaseDevice::updateCaseSensitivity);
+    disconnect(m_deviceWidget.data(), &DeviceWidget::highlightTermsChanged, this, &BaseDevice::updateSearchTerms);
+    disconnect(m_deviceWidget.data(), &DeviceWidget::findMatchRequested, this, &BaseDevice::findMatch);
+    disconnect(m_deviceWidget.data(), &DeviceWidget::clearLogRequested, this, &BaseDevice::clearLog);
     disconnect(&m_deviceWidget->getFilterLineEdit(), nullptr, this, nullptr);
-    disconnect(this, &BaseDevice::logReady, this, &BaseDevice::onLogReady);
+    disconnect(this, &BaseDevice::logReady, this, &BaseDevice::readLog);
+    if (!m_tabWidget.isNull())
+    {
+        disconnect(m_tabWidget.data(), &QTabWidget::currentChanged, this, &BaseDevice::onCurrentTabChanged);
+    }
 
+    m_deviceWidget->getLogView().setSource(nullptr);
     m_tabWidget.clear();
 }
 
@@ -161,38 +220,1041 @@ void BaseDevice::stopLogReadyTimer()
     m_logReadyTimer.stop();
 }
 
+int BaseDevice::getMaxLinesUpdate() const
+{
+    if (isOverloaded())
+    {
+        return CAPTURE_ONLY_MAX_LINES_UPDATE;
+    }
+    else
+    {
+        return MAX_LINES_UPDATE;
+    }
+}
+
+void BaseDevice::readLog()
+{
+    // the device schedules the next read if it has left some lines unread
+    m_logReadyTimer.stop();
+    m_readLines = 0;
+    onLogReady();
+    updateOverload(m_readLines, m_logReadyTimer.isActive());
+}
+
+void BaseDevice::checkOverload()
+{
+    // the rate drops to zero when the device stops logging, then there are no reads to update it
+    updateOverload(0, m_logReadyTimer.isActive());
+}
+
+void BaseDevice::updateOverload(const int lines, const bool backlog)
+{
+    const bool changed = m_overloadDetector.update(m_overloadClock.elapsed(), lines, backlog);
+    if (isOverloaded())
+    {
+        if (changed)
+        {
+            qDebug() << "BaseDevice::updateOverload" << m_id << "capture only";
+            m_backfillTimer.stop();
+            m_overloadTimer.start();
+        }
+        m_deviceWidget->getLogView().setBanner(tr("Rendering paused, %1 lines/s").arg(m_overloadDetector.getRate()));
+    }
+    else if (changed)
+    {
+        // the lines captured meanwhile were never matched, so they're all matched
+        // again newest-first as for a new filter, instead of catching up at once
+        qDebug() << "BaseDevice::updateOverload" << m_id << "resync";
+        m_overloadTimer.stop();
+        m_deviceWidget->getLogView().setBanner(QString());
+
+        CandidateQuery query;
+        findIndexedCandidates(query);
+        startMatching();
+        collectCandidates(query);
+        reloadTextEdit();
+    }
+}
+
+static QRegularExpression::PatternOptions getColumnTextRegexpOptions(const Qt::CaseSensitivity cs)
+{
+    QRegularExpression::PatternOptions options = QRegularExpression::DotMatchesEverythingOption;
+    if (cs == Qt::CaseInsensitive)
+    {
+        options |= QRegularExpression::CaseInsensitiveOption;
+    }
+    return options;
+}
+
 void BaseDevice::updateFilter(const QString& filter)
 {
     qDebug() << "BaseDevice::updateFilter(" << filter << ")";
 
     const QString regexpFilter(".*(" % filter % ").*");
     m_columnTextRegexp.setPattern(regexpFilter);
-    m_columnTextRegexp.setPatternOptions(QRegularExpression::DotMatchesEverythingOption);
+    m_columnTextRegexp.setPatternOptions(getColumnTextRegexpOptions(m_caseSensitivity));
 
     onUpdateFilter(filter);
 }
 
+void BaseDevice::updateCaseSensitivity(const Qt::CaseSensitivity cs)
+{
+    qDebug() << "BaseDevice::updateCaseSensitivity(" << cs << ")";
+
+    m_caseSensitivity = cs;
+    m_columnTextRegexp.setPatternOptions(getColumnTextRegexpOptions(m_caseSensitivity));
+
+    reloadTextEdit();
+}
+
+void BaseDevice::setFilters(const QString& filter)
+{
+    m_filters = filter.split(' ');
+    m_filtersValid = true;
+
+    // typed terms are compiled once, "since:" is relative to now
+    const QDateTime now = QDateTime::currentDateTime();
+    m_valueFilters.clear();
+    for (const QString& term : m_filters)
+    {
+        m_valueFilters.append(ValueFilter::parse(term, now));
+    }
+}
+
 void BaseDevice::addToLogBuffer(const QString& text)
 {
-    m_logBuffer->push(text);
+    ++m_readLines;
+
+    RecordFields fields;
+    parseLine(text, fields);
+
+    QStringRef keys[RecordIndex::KEYS];
+    getKeys(text, fields, keys);
+
+    const quint64 id = m_logBuffer->push(text);
+    const quint64 firstId = m_logBuffer->getFirstId();
+    m_recordIndex->add(id, fields, keys);
+    m_blockSummaries->add(id, getSearchableText(text, fields), fields);
+    m_deviceWidget->getLogView().trim(firstId);
+
+    if (!m_trigramIndexer.isNull())
+    {
+        m_trigramIndexer->add(id, text, getSearchableText(text, fields));
+        m_trigramIndexer->evict(firstId);
+    }
+
+    if (m_searchIndex.hasTerms())
+    {
+        m_searchIndex.trim(firstId);
+        m_searchIndex.add(id, *this);
+    }
+}
+
+void BaseDevice::getKeys(const QString& text, const RecordFields& fields, QStringRef keys[RecordIndex::KEYS]) const
+{
+    for (int key = 0; key < RecordIndex::KEYS; ++key)
+    {
+        const int column = getKeyColumn(static_cast<RecordIndex::Key>(key));
+        if (column >= 0 && fields.isParsed())
+        {
+            keys[key] = fields.getColumn(text, column);
+        }
+    }
+}
+
+void BaseDevice::applySettings(const int changes)
+{
+    qDebug() << "BaseDevice::applySettings" << m_id << changes;
+    if ((changes & (DeviceFacade::HistorySettings | DeviceFacade::IndexSettings)) != 0)
+    {
+        updateLogBufferSpace();
+    }
+
+    if ((changes & DeviceFacade::StyleSettings) != 0)
+    {
+        m_deviceWidget->restyleLogView();
+    }
+}
+
+void BaseDevice::resizeLogBuffer(const size_t lines)
+{
+    // the newest lines keep their ids, so the matches and the rendered rows stay valid;
+    // only the indexes sized by the capacity are refilled, from the fields parsed already
+    qDebug() << "resizeLogBuffer" << lines;
+    m_logBuffer->setCapacity(lines);
+    const quint64 firstId = m_logBuffer->getFirstId();
+    const quint64 endId = m_logBuffer->getEndId();
+
+    const QSharedPointer<RecordIndex> recordIndex = m_recordIndex;
+    m_recordIndex = QSharedPointer<RecordIndex>::create(lines);
+    m_blockSummaries = QSharedPointer<BlockSummaries>::create(lines);
+    for (quint64 id = firstId; id < endId; ++id)
+    {
+        const QString& text = m_logBuffer->at(id);
+        const RecordFields& fields = recordIndex->getFields(id);
+        QStringRef keys[RecordIndex::KEYS];
+        getKeys(text, fields, keys);
+        m_recordIndex->add(id, fields, keys);
+        m_blockSummaries->add(id, getSearchableText(text, fields), fields);
+    }
+
+    m_matchedIds.trim(firstId);
+    m_searchIndex.trim(firstId);
+    m_matchCache.forEachValue([firstId](CachedMatches& matches) {
+        matches.trim(firstId);
+    });
+    if (!m_trigramIndexer.isNull())
+    {
+        m_trigramIndexer->evict(firstId);
+    }
+
+    LogView& logView = m_deviceWidget->getLogView();
+    logView.setMaxRows(static_cast<int>(lines));
+    logView.trim(firstId);
 }
 
 void BaseDevice::updateLogBufferSpace()
 {
     const size_t lines = static_cast<size_t>(m_deviceFacade->getVisibleLines());
-    if (m_logBuffer.isNull() || m_logBuffer->getCapacity() != lines)
+    if (!m_logBuffer.isNull() && m_logBuffer->getCapacity() != lines)
+    {
+        resizeLogBuffer(lines);
+    }
+
+    const bool bufferChanged = m_logBuffer.isNull() || m_logBuffer->getCapacity() != lines;
+    if (bufferChanged)
     {
         qDebug() << "updateLogBufferSpace" << lines;
         m_logBuffer = QSharedPointer<StringRingBuffer>::create(m_deviceFacade->getVisibleLines());
+        m_recordIndex = QSharedPointer<RecordIndex>::create(lines);
+        m_blockSummaries = QSharedPointer<BlockSummaries>::create(lines);
+        startMatching();
+        m_renderedBeginId = 0;
+        m_matchCache.clear();
+        restartSearch();
+    }
+
+    const bool trigramIndex = m_deviceFacade->isTrigramIndexEnabled();
+    if (!trigramIndex)
+    {
+        m_trigramIndexer.clear();
+    }
+    else if (bufferChanged || m_trigramIndexer.isNull())
+    {
+        // indexes the lines pushed from now on, the older ones are always scanned
+        const size_t memoryBudget = TRIGRAM_INDEX_MEMORY_BUDGET;
+        m_trigramIndexer = QSharedPointer<TrigramIndexer>::create(memoryBudget);
+    }
+}
+
+static bool isLiteralFilter(const QString& filter)
+{
+    static const QString regexpSpecialCharacters("\\^$.|?*+()[]{}");
+    for (const QChar c : filter)
+    {
+        if (regexpSpecialCharacters.contains(c))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static QStringRef filterColumn(const QString& filter)
+{
+    const int colon = filter.indexOf(':');
+    if (colon <= 0)
+    {
+        return QStringRef();
+    }
+
+    for (int i = 0; i < colon; ++i)
+    {
+        if (!filter.at(i).isLetter())
+        {
+            return QStringRef();
+        }
+    }
+    return filter.leftRef(colon + 1);
+}
+
+static bool hasEmptyColumnFilter(const QStringList& filters)
+{
+    for (const QString& filter : filters)
+    {
+        const QStringRef column = filterColumn(filter);
+        if (!column.isEmpty() && column.length() == filter.length())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isValueFilter(const QString& filter)
+{
+    return ValueFilter::parse(filter).isValid();
+}
+
+// matches of "since:" terms depend on when they were compiled
+static bool hasRelativeTimeFilter(const QStringList& filters)
+{
+    for (const QString& filter : filters)
+    {
+        if (filter.startsWith(QLatin1String("since:")))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool hasLiteralFilters(const QStringList& filters)
+{
+    return std::all_of(filters.constBegin(), filters.constEnd(), isLiteralFilter);
+}
+
+// terms of a literal filter can be reordered, the whole filter regexp can't match
+// unless every term is found anyway; a filter can't contain a line break,
+// so it marks the case insensitive keys
+static QString getMatchCacheKey(const QStringList& filters, const Qt::CaseSensitivity cs)
+{
+    const QString prefix(cs == Qt::CaseInsensitive ? "\n" : "");
+    if (!hasLiteralFilters(filters))
+    {
+        return prefix % filters.join(' ');
+    }
+
+    QStringList terms(filters);
+    terms.removeAll(QString());
+    terms.sort();
+    terms.removeDuplicates();
+    return prefix % terms.join(' ');
+}
+
+static QStringRef getTrigramSearchTerm(const QString& filter, const QStringRef& column)
+{
+    if (column.isEmpty())
+    {
+        return QStringRef(&filter);
+    }
+    else if (column == QLatin1String("text:"))
+    {
+        return filter.midRef(column.length());
+    }
+    else if (column == QLatin1String("pid:") || column == QLatin1String("tid:") || column == QLatin1String("tag:") ||
+             column == QLatin1String("time:") || column == QLatin1String("since:"))
+    {
+        return QStringRef();
+    }
+    else
+    {
+        // not a column of any device, so it's searched in the text
+        return QStringRef(&filter);
+    }
+}
+
+static int getKeyByFilterColumn(const QStringRef& column)
+{
+    if (column == QLatin1String("tag:"))
+    {
+        return RecordIndex::TagKey;
+    }
+    else if (column == QLatin1String("pid:"))
+    {
+        return RecordIndex::PidKey;
+    }
+    else
+    {
+        return -1;
     }
 }
 
 void BaseDevice::filterAndAddFromLogBufferToTextEdit()
 {
-    for (auto it = m_logBuffer->constBegin(); it.isValid(); it++)
+    m_backfillTimer.stop();
+    updateMatchedIds();
+
+    if (m_renderingSuspended)
+    {
+        // rendered from the end once it's resumed
+        m_renderedBeginId = m_logBuffer->getEndId();
+        m_suspendedEndId = m_renderedBeginId;
+        m_deviceWidget->highlightFilterLineEdit(!m_filtersValid);
+        return;
+    }
+
+    // the last screen goes first, the older lines are backfilled above it
+    m_renderedBeginId = m_logBuffer->getEndId();
+    renderOlderMatches(m_deviceWidget->getVisibleLineCount(), RELOAD_SLICE_TIME);
+    if (!isBackfillDone())
+    {
+        m_backfillTimer.start();
+    }
+
+    m_deviceWidget->highlightFilterLineEdit(!m_filtersValid);
+}
+
+void BaseDevice::renderOlderMatches(const int maxLines, const int maxTime)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const quint64 firstId = m_logBuffer->getFirstId();
+    m_matchedIds.trim(firstId);
+
+    const int verbosityLevel = m_deviceWidget->getVerbosityLevel();
+    int olderMatches = static_cast<int>(std::lower_bound(m_matchedIds.begin(), m_matchedIds.end(), m_renderedBeginId) - m_matchedIds.begin());
+    QVector<quint64> headMatches;
+    int headPosition = 0;
+
+    QVector<quint64> ids;
+    bool outOfTime = false;
+    for (;;)
+    {
+        while (ids.size() < maxLines)
+        {
+            quint64 id = 0;
+            if (olderMatches > 0)
+            {
+                id = m_matchedIds.at(--olderMatches);
+            }
+            else if (headPosition < headMatches.size())
+            {
+                id = headMatches[headPosition++];
+            }
+            else
+            {
+                break;
+            }
+
+            m_renderedBeginId = id;
+            if (id < m_clearedEndId)
+            {
+                break;
+            }
+            else if (m_recordIndex->getFields(id).verbosity <= verbosityLevel)
+            {
+                ids.append(id);
+            }
+            else if (timer.elapsed() >= maxTime)
+            {
+                outOfTime = true;
+                break;
+            }
+            else
+            {
+                // the matches of the hidden levels are skipped at once, down to the previous line of a shown level
+                quint64 shownId = 0;
+                const quint64 skipTo = m_recordIndex->findPreviousUpToVerbosityLevel(verbosityLevel, id, shownId) ? shownId + 1 : 0;
+                olderMatches = static_cast<int>(std::lower_bound(m_matchedIds.begin(), m_matchedIds.begin() + olderMatches, skipTo) - m_matchedIds.begin());
+                if (olderMatches == 0)
+                {
+                    headPosition = static_cast<int>(std::upper_bound(headMatches.begin() + headPosition, headMatches.end(), skipTo, std::greater<quint64>()) - headMatches.begin());
+                }
+            }
+        }
+
+        if (outOfTime || ids.size() >= maxLines || m_renderedBeginId < m_clearedEndId)
+        {
+            break;
+        }
+
+        m_renderedBeginId = qMin(m_renderedBeginId, m_matchedBeginId);
+        if (isBackfillDone() || timer.elapsed() >= maxTime)
+        {
+            break;
+        }
+
+        matchLogBufferHead(HEAD_SCAN_LINES, headMatches);
+    }
+
+    std::reverse(headMatches.begin(), headMatches.end());
+    m_matchedIds.prepend(headMatches);
+
+    if (!ids.isEmpty())
+    {
+        std::reverse(ids.begin(), ids.end());
+        m_deviceWidget->prependRecords(ids);
+    }
+}
+
+bool BaseDevice::isBackfillDone() const
+{
+    return m_renderedBeginId <= qMax(m_logBuffer->getFirstId(), m_clearedEndId);
+}
+
+void BaseDevice::formatRecord(const quint64 id, LogLine& line) const
+{
+    if (m_logBuffer->contains(id))
+    {
+        formatLine(m_logBuffer->at(id), m_recordIndex->getFields(id), line);
+    }
+}
+
+void BaseDevice::backfillTextEdit()
+{
+    renderOlderMatches(BACKFILL_MAX_LINES, RELOAD_SLICE_TIME);
+    if (isBackfillDone())
+    {
+        qDebug() << "BaseDevice::backfillTextEdit done";
+        m_backfillTimer.stop();
+    }
+}
+
+void BaseDevice::onScrolledToTop()
+{
+    if (!isBackfillDone())
+    {
+        renderOlderMatches(m_deviceWidget->getVisibleLineCount(), RELOAD_SLICE_TIME);
+    }
+}
+
+void BaseDevice::onCurrentTabChanged(const int index)
+{
+    setRenderingSuspended(m_tabWidget->widget(index) != m_deviceWidget.data());
+}
+
+void BaseDevice::setRenderingSuspended(const bool suspended)
+{
+    if (suspended == m_renderingSuspended)
+    {
+        return;
+    }
+
+    qDebug() << "BaseDevice::setRenderingSuspended" << m_id << suspended;
+    m_renderingSuspended = suspended;
+    if (suspended)
+    {
+        m_backfillTimer.stop();
+        m_suspendedEndId = m_logBuffer->getEndId();
+
+        const int releaseMinutes = m_deviceFacade->getReleaseHiddenTabsMinutes();
+        if (releaseMinutes > 0)
+        {
+            m_releaseViewTimer.start(releaseMinutes * 60 * 1000);
+        }
+        return;
+    }
+
+    m_releaseViewTimer.stop();
+    appendSuspendedMatches();
+    if (m_deviceWidget->getLogView().getModel().size() < m_deviceWidget->getVisibleLineCount())
+    {
+        renderOlderMatches(m_deviceWidget->getVisibleLineCount(), RELOAD_SLICE_TIME);
+    }
+    if (!isBackfillDone())
+    {
+        m_backfillTimer.start();
+    }
+}
+
+void BaseDevice::releaseLogView()
+{
+    // the rows are rebuilt from the log buffer once the tab is shown again
+    qDebug() << "BaseDevice::releaseLogView" << m_id;
+    m_deviceWidget->releaseLogView();
+    m_renderedBeginId = m_logBuffer->getEndId();
+    m_suspendedEndId = m_renderedBeginId;
+}
+
+void BaseDevice::clearLog()
+{
+    // the cleared lines stay in the log buffer, they're just never rendered again
+    qDebug() << "BaseDevice::clearLog" << m_id;
+    m_backfillTimer.stop();
+    m_clearedEndId = m_logBuffer->getEndId();
+    m_renderedBeginId = m_clearedEndId;
+    m_suspendedEndId = qMax(m_suspendedEndId, m_clearedEndId);
+    m_deviceWidget->getLogView().clearUpTo(m_clearedEndId);
+}
+
+void BaseDevice::appendSuspendedMatches()
+{
+    // the lines matched while suspended are appended at once, only the newest ones fit in the view
+    m_matchedIds.trim(m_logBuffer->getFirstId());
+    const quint64* const begin = std::lower_bound(m_matchedIds.begin(), m_matchedIds.end(), m_suspendedEndId);
+    const int maxRows = m_deviceFacade->getVisibleLines();
+    const int verbosityLevel = m_deviceWidget->getVerbosityLevel();
+
+    QVector<quint64> ids;
+    for (const quint64* it = m_matchedIds.end(); it != begin && ids.size() < maxRows;)
+    {
+        --it;
+        if (m_recordIndex->getFields(*it).verbosity <= verbosityLevel)
+        {
+            ids.append(*it);
+        }
+    }
+
+    for (auto it = ids.crbegin(); it != ids.crend(); ++it)
+    {
+        m_deviceWidget->addRecord(*it);
+    }
+    m_suspendedEndId = m_logBuffer->getEndId();
+}
+
+void BaseDevice::updateSearchTerms(const QStringList& terms, const Qt::CaseSensitivity cs)
+{
+    if (m_searchIndex.setTerms(terms, cs, m_logBuffer->getEndId()))
+    {
+        restartSearch();
+    }
+}
+
+void BaseDevice::restartSearch()
+{
+    // the whole lines are searched as they're displayed; the block summaries only cover
+    // the searchable text, so they can't tell which blocks to skip
+    m_searchIndex.restart(m_logBuffer->getEndId());
+    m_searchTimer.stop();
+    m_findPending = false;
+    if (!isSearchDone())
+    {
+        m_searchTimer.start();
+    }
+}
+
+void BaseDevice::searchOlderMatches()
+{
+    m_searchIndex.searchOlder(*this, m_logBuffer->getFirstId(), RELOAD_SLICE_TIME);
+    if (isSearchDone())
+    {
+        qDebug() << "BaseDevice::searchOlderMatches done" << m_searchIndex.getIds().size();
+        m_searchTimer.stop();
+    }
+
+    if (m_findPending && jumpToMatch(m_findBackward))
+    {
+        m_findPending = false;
+    }
+}
+
+void BaseDevice::findMatch(const bool backward)
+{
+    // the lines not searched yet are left to the background pass, which retries the jump
+    m_findPending = !jumpToMatch(backward);
+    m_findBackward = backward;
+}
+
+bool BaseDevice::jumpToMatch(const bool backward)
+{
+    LogView& logView = m_deviceWidget->getLogView();
+    const LogModel& model = logView.getModel();
+    if (!m_searchIndex.hasTerms() || model.isEmpty())
+    {
+        return true;
+    }
+
+    m_searchIndex.trim(m_logBuffer->getFirstId());
+    const RecordIdList& searchIds = m_searchIndex.getIds();
+    const quint64 searchedBeginId = qMax(m_searchIndex.getSearchedBeginId(), m_logBuffer->getFirstId());
+
+    // the search goes on from the selected row, otherwise from the top of the screen, which is included;
+    // an extra line has no id, so the record above it stands for it
+    int row = logView.getCursorRow();
+    const bool fromCursor = row >= 0;
+    if (!fromCursor)
+    {
+        row = logView.getFirstVisibleRow();
+    }
+    row = qBound(0, row, model.size() - 1);
+    while (row > 0 && LogModel::isExtraLine(model.at(row)))
+    {
+        --row;
+    }
+    const quint64 cursorId = LogModel::isExtraLine(model.at(row)) ? 0 : model.at(row);
+
+    // the matches which aren't rows, because of the filters or the verbosity, are skipped;
+    // all the lines from searchedBeginId on are searched, so the ones found there are the nearest
+    if (backward)
+    {
+        const quint64* it = std::lower_bound(searchIds.begin(), searchIds.end(), cursorId);
+        while (it != searchIds.begin())
+        {
+            --it;
+            const int matchRow = model.findRow(*it);
+            if (matchRow >= 0)
+            {
+                logView.selectRow(matchRow);
+                return true;
+            }
+        }
+        if (!isSearchDone())
+        {
+            return false;
+        }
+    }
+    else
+    {
+        const quint64 beginId = fromCursor ? cursorId + 1 : cursorId;
+        if (beginId < searchedBeginId)
+        {
+            return false;
+        }
+
+        for (const quint64* it = std::lower_bound(searchIds.begin(), searchIds.end(), beginId); it != searchIds.end(); ++it)
+        {
+            const int matchRow = model.findRow(*it);
+            if (matchRow >= 0)
+            {
+                logView.selectRow(matchRow);
+                return true;
+            }
+        }
+    }
+    qDebug() << "BaseDevice::findMatch no more matches" << backward;
+    return true;
+}
+
+void BaseDevice::filterAndAddLatestFromLogBufferToTextEdit()
+{
+    if (isOverloaded())
+    {
+        return;
+    }
+
+    const quint64 id = m_logBuffer->getEndId() - 1;
+    m_matchedIds.trim(m_logBuffer->getFirstId());
+    matchLogBufferTail();
+
+    const RecordFields& fields = m_recordIndex->getFields(id);
+    const bool matches = !m_matchedIds.isEmpty() && m_matchedIds.last() == id;
+    if (matches && !m_renderingSuspended && fields.verbosity <= m_deviceWidget->getVerbosityLevel())
+    {
+        m_deviceWidget->addRecord(id);
+    }
+
+    m_deviceWidget->highlightFilterLineEdit(!m_filtersValid);
+}
+
+void BaseDevice::updateMatchedIds()
+{
+    const quint64 firstId = m_logBuffer->getFirstId();
+    m_matchedIds.trim(firstId);
+
+    if (m_filters != m_matchedFilters || m_caseSensitivity != m_matchedCaseSensitivity)
+    {
+        cacheMatchedIds();
+        if (restoreCachedMatchedIds())
+        {
+            return;
+        }
+
+        // the lines are all matched newest-first by renderOlderMatches(),
+        // the candidates narrow them down once they're collected
+        CandidateQuery query;
+        findIndexedCandidates(query);
+        query.refinement = !isRestorePending() && isFilterRefinement(m_filters);
+        if (query.refinement)
+        {
+            query.previousCandidates = m_headCandidates;
+            query.previousCandidateCount = m_headCandidateCount;
+            query.previousCandidatesBeginId = m_headCandidatesBeginId;
+            query.previousMatches = m_matchedIds;
+            query.previousMatchedEndId = m_matchedEndId;
+        }
+
+        qDebug() << "refinement" << query.refinement << "indexed" << query.isIndexed();
+        startMatching();
+        collectCandidates(query);
+    }
+
+    matchLogBufferTail();
+}
+
+void BaseDevice::startMatching()
+{
+    const quint64 endId = m_logBuffer->getEndId();
+    m_headCandidates.clear();
+    m_headCandidateCount = 0;
+    m_headCandidatesBeginId = endId;
+    m_restoredIds.clear();
+    m_restoredBeginId = endId;
+    m_restoredEndId = endId;
+    m_matchedIds.clear();
+    m_matchedBeginId = endId;
+    m_matchedEndId = endId;
+    m_matchedFilters = m_filters;
+    m_matchedCaseSensitivity = m_caseSensitivity;
+    ++m_candidatesGeneration;
+}
+
+void BaseDevice::collectCandidates(CandidateQuery& query)
+{
+    if (!query.refinement && !query.isIndexed())
+    {
+        return;
+    }
+
+    query.generation = m_candidatesGeneration;
+    m_candidatesWatcher.setFuture(QtConcurrent::run(&CandidateQuery::collect, query));
+}
+
+void BaseDevice::onCandidatesCollected()
+{
+    const CandidateQuery::Result result = m_candidatesWatcher.result();
+    if (result.generation != m_candidatesGeneration)
+    {
+        return;
+    }
+
+    // the lines from m_matchedBeginId were matched meanwhile, only the older candidates are left
+    qDebug() << "BaseDevice::onCandidatesCollected" << result.ids.size() << "candidates from" << result.beginId;
+    if (m_matchedBeginId > result.beginId)
+    {
+        m_headCandidates = result.ids;
+        m_headCandidateCount = static_cast<int>(std::lower_bound(m_headCandidates.begin(), m_headCandidates.end(), m_matchedBeginId) - m_headCandidates.begin());
+        m_headCandidatesBeginId = result.beginId;
+    }
+}
+
+void BaseDevice::cacheMatchedIds()
+{
+    if (hasEmptyColumnFilter(m_matchedFilters) || hasRelativeTimeFilter(m_matchedFilters))
+    {
+        return;
+    }
+
+    CachedMatches matches;
+    if (isRestorePending())
+    {
+        // nothing older than the lines pushed since the restored matches were cached
+        // was matched yet, so they're cached again as they were
+        matches.ids = m_restoredIds;
+        matches.beginId = m_restoredBeginId;
+        matches.endId = m_restoredEndId;
+    }
+    else
+    {
+        matches.ids = m_matchedIds;
+        matches.beginId = m_matchedBeginId;
+        matches.endId = m_matchedEndId;
+    }
+    matches.headCandidates = m_headCandidates;
+    matches.headCandidateCount = m_headCandidateCount;
+    matches.headCandidatesBeginId = m_headCandidatesBeginId;
+    m_matchCache.insert(getMatchCacheKey(m_matchedFilters, m_matchedCaseSensitivity), matches);
+}
+
+bool BaseDevice::restoreCachedMatchedIds()
+{
+    CachedMatches matches;
+    if (hasEmptyColumnFilter(m_filters) || hasRelativeTimeFilter(m_filters) || !m_matchCache.take(getMatchCacheKey(m_filters, m_caseSensitivity), matches))
+    {
+        return false;
+    }
+
+    // the lines pushed since then are matched newest-first by matchLogBufferHead(),
+    // which takes the restored matches as they are once it gets to them
+    qDebug() << "restoreCachedMatchedIds" << m_filters << ";" << matches.ids.size() << "matches;"
+             << (m_logBuffer->getEndId() - qMax(matches.endId, m_logBuffer->getFirstId())) << "lines behind";
+    startMatching();
+    m_restoredIds = matches.ids;
+    m_restoredBeginId = matches.beginId;
+    m_restoredEndId = matches.endId;
+    m_headCandidates = matches.headCandidates;
+    m_headCandidateCount = matches.headCandidateCount;
+    m_headCandidatesBeginId = matches.headCandidatesBeginId;
+    return true;
+}
+
+void BaseDevice::findIndexedCandidates(CandidateQuery& query) const
+{
+    const quint64 firstId = m_logBuffer->getFirstId();
+    const quint64 endId = m_logBuffer->getEndId();
+    query.firstId = firstId;
+    query.endId = endId;
+    if (hasEmptyColumnFilter(m_filters))
+    {
+        return;
+    }
+
+    for (int i = 0; i < m_filters.size(); ++i)
+    {
+        const QString& filter = m_filters[i];
+        const ValueFilter& valueFilter = m_valueFilters[i];
+        if (valueFilter.isValid())
+        {
+            if (!hasValue(valueFilter.getValue()))
+            {
+                continue;
+            }
+
+            // the blocks whose values are all out of the range are skipped
+            CandidateQuery::ValueTerm term;
+            term.values = m_recordIndex->getValues(valueFilter.getValue());
+            term.min = valueFilter.getMin();
+            term.max = valueFilter.getMax();
+            m_blockSummaries->findRangesWithValueIn(valueFilter.getValue(), term.min, term.max, firstId, endId, term.ranges);
+            query.valueTerms.append(term);
+        }
+        else
+        {
+            const QStringRef column = filterColumn(filter);
+            const int key = getKeyByFilterColumn(column);
+            if (key < 0 || getKeyColumn(static_cast<RecordIndex::Key>(key)) < 0)
+            {
+                continue;
+            }
+
+            query.keyTerms.append(m_recordIndex->getPostingsWithKeyContaining(
+                static_cast<RecordIndex::Key>(key),
+                filter.midRef(column.length()),
+                m_caseSensitivity
+            ));
+        }
+    }
+
+    if (!hasLiteralFilters(m_filters))
+    {
+        return;
+    }
+
+    // a line can match a literal text term only if it contains the term,
+    // hence only if it contains all the trigrams of the term
+    for (const QString& filter : m_filters)
+    {
+        const QStringRef term = getTrigramSearchTerm(filter, filterColumn(filter));
+        QVector<RecordIdRange> ranges;
+        // the trigram index is case sensitive, unlike the block summaries
+        const bool found = !m_trigramIndexer.isNull() && m_caseSensitivity == Qt::CaseSensitive
+            ? m_trigramIndexer->findCandidates(term, firstId, endId, ranges)
+            : m_blockSummaries->findRangesContaining(term, firstId, endId, ranges);
+
+        // the ranges are expanded by the worker thread, unless they cover every line anyway
+        if (found && !(ranges.size() == 1 && ranges.first().begin == firstId && ranges.first().end == endId))
+        {
+            query.ranges.append(ranges);
+        }
+    }
+}
+
+void BaseDevice::matchLogBufferHead(const int maxLines, QVector<quint64>& matches)
+{
+    const quint64 firstId = m_logBuffer->getFirstId();
+    const quint64 candidatesBeginId = qMax(m_headCandidatesBeginId, firstId);
+    quint64 id = qMax(m_matchedBeginId, firstId);
+    for (int lines = 0; id > firstId && lines < maxLines; ++lines)
     {
-        filterAndAddToTextEdit(*it);
+        if (id > m_restoredEndId)
+        {
+            // pushed since the restored matches were cached
+            --id;
+        }
+        else if (id > m_restoredBeginId)
+        {
+            // the restored matches are taken at once, they were matched already
+            for (const quint64* it = m_restoredIds.end(); it != m_restoredIds.begin() && *(it - 1) >= firstId;)
+            {
+                matches.append(*--it);
+            }
+            m_restoredIds.clear();
+            id = m_restoredBeginId;
+            continue;
+        }
+        else if (id > candidatesBeginId)
+        {
+            if (m_headCandidateCount > 0 && m_headCandidates.at(m_headCandidateCount - 1) >= candidatesBeginId)
+            {
+                id = m_headCandidates.at(--m_headCandidateCount);
+            }
+            else
+            {
+                // no candidates left, nothing else can match up to candidatesBeginId
+                m_headCandidates.clear();
+                m_headCandidateCount = 0;
+                id = candidatesBeginId;
+                continue;
+            }
+        }
+        else
+        {
+            --id;
+        }
+
+        if (recordMatchesFilters(id))
+        {
+            matches.append(id);
+        }
     }
+
+    m_matchedBeginId = id;
+    m_headCandidatesBeginId = qMin(m_headCandidatesBeginId, id);
+}
+
+void BaseDevice::matchLogBufferTail()
+{
+    const quint64 endId = m_logBuffer->getEndId();
+    for (quint64 id = qMax(m_matchedEndId, m_logBuffer->getFirstId()); id < endId; ++id)
+    {
+        if (recordMatchesFilters(id))
+        {
+            m_matchedIds.append(id);
+        }
+    }
+    m_matchedEndId = endId;
+}
+
+bool BaseDevice::recordMatchesFilters(const quint64 id)
+{
+    return matchesFilters(m_logBuffer->at(id), m_recordIndex->getFields(id));
+}
+
+bool BaseDevice::isFilterRefinement(const QStringList& filters) const
+{
+    if (hasEmptyColumnFilter(filters) || m_caseSensitivity != m_matchedCaseSensitivity)
+    {
+        return false;
+    }
+
+    for (const QString& filter : filters)
+    {
+        if (!isLiteralFilter(filter))
+        {
+            return false;
+        }
+    }
+
+    // every previous term must be implied by some new term
+    // of the same column which contains it
+    for (const QString& previous : m_matchedFilters)
+    {
+        if (previous.isEmpty())
+        {
+            continue;
+        }
+
+        if (!isLiteralFilter(previous))
+        {
+            return false;
+        }
+
+        const QStringRef previousColumn = filterColumn(previous);
+        const QStringRef previousValue = previous.midRef(previousColumn.length());
+        const bool previousTyped = isValueFilter(previous);
+
+        // a typed term is only implied by itself, a wider range would contain it as well
+        bool implied = false;
+        for (const QString& filter : filters)
+        {
+            const QStringRef column = filterColumn(filter);
+            if (previousTyped
+                ? filter == previous
+                : column == previousColumn && !isValueFilter(filter) && TextSearch::contains(filter.midRef(column.length()), previousValue, m_caseSensitivity))
+            {
+                implied = true;
+                break;
+            }
+        }
+
+        if (!implied)
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 bool BaseDevice::columnMatches(const QString& column, const QStringRef& filter, const QStringRef& originalValue, bool& filtersValid, bool& columnFound)
@@ -205,7 +1267,7 @@ bool BaseDevice::columnMatches(const QString& column, const QStringRef& filter,
         {
             filtersValid = false;
         }
-        else if (!originalValue.contains(value))
+        else if (!TextSearch::contains(originalValue, value, m_caseSensitivity))
         {
             return false;
         }
@@ -215,7 +1277,7 @@ bool BaseDevice::columnMatches(const QString& column, const QStringRef& filter,
 
 bool BaseDevice::columnTextMatches(const QStringRef& filter, const QString& text)
 {
-    if (filter.isEmpty() || text.contains(filter))
+    if (filter.isEmpty() || TextSearch::contains(QStringRef(&text), filter, m_caseSensitivity))
     {
         return true;
     }
@@ -20,9 +20,20 @@
 
 #include "ui/DeviceWidget.h"
 #include "DeviceFacade.h"
+#include "BlockSummaries.h"
+#include "CandidateQuery.h"
 #include "DataTypes.h"
+#include "LruCache.h"
+#include "OverloadDetector.h"
+#include "RecordIdList.h"
+#include "RecordIndex.h"
+#include "SearchIndex.h"
 #include "StringRingBuffer.h"
+#include "TrigramIndexer.h"
+#include "ValueFilter.h"
 
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QPointer>
 #include <QProcess>
 #include <QRegularExpression>
@@ -35,14 +46,21 @@
 
 using namespace DataTypes;
 
-class BaseDevice : public QObject
+class BaseDevice : public QObject, public LogSource
 {
     Q_OBJECT
 
 public:
     static const int MAX_LINES_UPDATE = 30;
+    static const int CAPTURE_ONLY_MAX_LINES_UPDATE = 1000;
     static const int COMPLETION_ADD_TIMEOUT = 10 * 1000;
     static const int LOG_READY_TIMEOUT = 1;
+    static const int BACKFILL_INTERVAL = 0;
+    static const int BACKFILL_MAX_LINES = 200;
+    static const int RELOAD_SLICE_TIME = 8;
+    static const int HEAD_SCAN_LINES = 256;
+    static const int MATCH_CACHE_SIZE = 8;
+    static const size_t TRIGRAM_INDEX_MEMORY_BUDGET = 64 * 1024 * 1024;
 
     static QSharedPointer<BaseDevice> create(
         QPointer<QTabWidget> parent,
@@ -63,7 +81,12 @@ public:
 
     void updateTabWidget();
     virtual void onUpdateFilter(const QString& filter) = 0;
-    virtual void filterAndAddToTextEdit(const QString& line) = 0;
+    virtual void parseLine(const QString& line, RecordFields& fields) const = 0;
+    virtual bool matchesFilters(const QString& line, const RecordFields& fields) = 0;
+    virtual void formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const = 0;
+    virtual int getKeyColumn(const RecordIndex::Key key) const { (void) key; return -1; }
+    virtual bool hasValue(const RecordFields::Value value) const { (void) value; return false; }
+    virtual QStringRef getSearchableText(const QString& line, const RecordFields& fields) const = 0;
     virtual const char* getPlatformName() const = 0;
     virtual void reloadTextEdit() = 0;
 
@@ -88,16 +111,42 @@ public:
 
     inline const QString& getCurrentLogFileName() const { return m_currentLogFileName; }
 
+    void setFilters(const QString& filter);
     void addToLogBuffer(const QString& text);
     virtual void writeToLogFile(const QString& line) { addToLogBuffer(line); }
 
     void updateLogBufferSpace();
+    void resizeLogBuffer(const size_t lines);
+    void getKeys(const QString& text, const RecordFields& fields, QStringRef keys[RecordIndex::KEYS]) const;
+
+    // redoes only what the changed DeviceFacade::SettingsChange flags require
+    void applySettings(const int changes);
     void filterAndAddFromLogBufferToTextEdit();
+    void filterAndAddLatestFromLogBufferToTextEdit();
+    void updateMatchedIds();
+    void matchLogBufferTail();
+    void matchLogBufferHead(const int maxLines, QVector<quint64>& matches);
+    void renderOlderMatches(const int maxLines, const int maxTime);
+    bool isBackfillDone() const;
+    void formatRecord(const quint64 id, LogLine& line) const override;
+    void cacheMatchedIds();
+    bool restoreCachedMatchedIds();
+    bool recordMatchesFilters(const quint64 id);
+    bool isFilterRefinement(const QStringList& filters) const;
+    void findIndexedCandidates(CandidateQuery& query) const;
     bool columnMatches(const QString& column, const QStringRef& filter, const QStringRef& originalValue, bool& filtersValid, bool& columnFound);
     bool columnTextMatches(const QStringRef& filter, const QString& text);
 
     void scheduleLogReady();
     void stopLogReadyTimer();
+    int getMaxLinesUpdate() const;
+
+    // an overloaded device only captures the lines, until they come slowly enough to render them
+    inline bool isOverloaded() const { return m_overloadDetector.isOverloaded(); }
+
+    // a suspended device keeps capturing and matching, but doesn't render anything
+    void setRenderingSuspended(const bool suspended);
+    inline bool isRenderingSuspended() const { return m_renderingSuspended; }
 
 signals:
     void logReady();
@@ -105,6 +154,18 @@ signals:
 private slots:
     void addFilterAsCompletion();
     void updateFilter(const QString& filter);
+    void updateCaseSensitivity(const Qt::CaseSensitivity cs);
+    void backfillTextEdit();
+    void onScrolledToTop();
+    void onCurrentTabChanged(const int index);
+    void releaseLogView();
+    void clearLog();
+    void readLog();
+    void checkOverload();
+    void updateSearchTerms(const QStringList& terms, const Qt::CaseSensitivity cs);
+    void searchOlderMatches();
+    void findMatch(const bool backward);
+    void onCandidatesCollected();
     virtual void onLogReady() = 0;
 
 protected:
@@ -120,16 +181,91 @@ protected:
     QString m_currentLogFileName;
     bool m_dirtyFilter;
     bool m_filtersValid;
+    Qt::CaseSensitivity m_caseSensitivity;
     QStringList m_filters;
+    QVector<ValueFilter> m_valueFilters;
     QSharedPointer<StringRingBuffer> m_logBuffer;
+    QSharedPointer<RecordIndex> m_recordIndex;
+    QSharedPointer<BlockSummaries> m_blockSummaries;
+    QSharedPointer<TrigramIndexer> m_trigramIndexer;
+    RecordIdList m_matchedIds;
+    quint64 m_matchedBeginId;
+    quint64 m_matchedEndId;
+    QStringList m_matchedFilters;
+    Qt::CaseSensitivity m_matchedCaseSensitivity;
+    RecordIdList m_headCandidates;
+    int m_headCandidateCount;
+    quint64 m_headCandidatesBeginId;
+    RecordIdList m_restoredIds;
+    quint64 m_restoredBeginId;
+    quint64 m_restoredEndId;
+    quint64 m_renderedBeginId;
+    bool m_renderingSuspended;
+    quint64 m_suspendedEndId;
+    quint64 m_clearedEndId;
     QRegularExpression m_columnTextRegexp;
     QString m_tempBuffer;
     QTextStream m_tempStream;
 
 private:
+    struct CachedMatches
+    {
+        RecordIdList ids;
+        quint64 beginId = 0;
+        quint64 endId = 0;
+        RecordIdList headCandidates;
+        int headCandidateCount = 0;
+        quint64 headCandidatesBeginId = 0;
+
+        // drops the ids evicted from the log buffer; nothing older than firstId is left to match
+        void trim(const quint64 firstId)
+        {
+            ids.trim(firstId);
+            beginId = qMax(beginId, firstId);
+            endId = qMax(endId, beginId);
+
+            const int candidates = headCandidates.size();
+            headCandidates.trim(firstId);
+            headCandidateCount = qMax(0, headCandidateCount - (candidates - headCandidates.size()));
+            headCandidatesBeginId = qMax(headCandidatesBeginId, firstId);
+        }
+    };
+
+    void appendSuspendedMatches();
+    void updateOverload(const int lines, const bool backlog);
+    void startMatching();
+
+    // every line is matched until the candidates are collected, they narrow down the lines left then
+    void collectCandidates(CandidateQuery& query);
+
+    // the lines pushed since restored matches were cached are matched before them, newest first
+    inline bool isRestorePending() const { return m_matchedBeginId > m_restoredBeginId; }
+
+    // the search index holds the ids of all the lines containing a highlighted term, whether
+    // they pass the filters or not; the older lines are searched newest first in time slices
+    void restartSearch();
+
+    // selects the next match from the cursor; returns false if it may be in the lines
+    // not searched yet, the jump is retried after the next slice then
+    bool jumpToMatch(const bool backward);
+    inline bool isSearchDone() const { return m_searchIndex.isDone(m_logBuffer->getFirstId()); }
+
+    LruCache<QString, CachedMatches> m_matchCache;
     QString m_completionToAdd;
     QTimer m_completionAddTimer;
     QTimer m_logReadyTimer;
+    QTimer m_backfillTimer;
+    QTimer m_releaseViewTimer;
+    OverloadDetector m_overloadDetector;
+    QElapsedTimer m_overloadClock;
+    QTimer m_overloadTimer;
+    int m_readLines;
+    SearchIndex m_searchIndex;
+    QTimer m_searchTimer;
+    bool m_findPending;
+    bool m_findBackward;
+    QFutureWatcher<CandidateQuery::Result> m_candidatesWatcher;
+    int m_candidatesGeneration;
 };
 
 #endif // BASEDEVICE_H
@@ -42,6 +42,10 @@ DeviceFacade::DeviceFacade(QPointer<QTabWidget> parent)
     , m_darkTheme(false)
     , m_clearAndroidLog(true)
     , m_autoRemoveFilesHours(48)
+    , m_trigramIndex(false)
+    , m_releaseHiddenTabsMinutes(10)
+    , m_maxLineLength(4096)
+    , m_settingsChanges(0)
 {
     qDebug() << "DeviceFacade";
 
@@ -113,6 +117,12 @@ void DeviceFacade::trackersUpdate()
 
 void DeviceFacade::loadSettings(const QSettings& s)
 {
+    const int previousVisibleBlocks = m_visibleBlocks;
+    const QFont previousLogFont = m_logFont;
+    const bool previousDarkTheme = m_darkTheme;
+    const int previousMaxLineLength = m_maxLineLength;
+    const bool previousTrigramIndex = m_trigramIndex;
+
     const QVariant visibleBlocks = s.value("visibleBlocks");
     if (visibleBlocks.isValid())
     {
@@ -153,6 +163,7 @@ void DeviceFacade::loadSettings(const QSettings& s)
         m_darkTheme = darkTheme.toBool();
     }
     m_colorTheme = ColorTheme::create(m_darkTheme);
+    updateThemeFormats();
 
     const QVariant clearAndroidLog = s.value("clearAndroidLog");
     if (clearAndroidLog.isValid())
@@ -185,6 +196,38 @@ void DeviceFacade::loadSettings(const QSettings& s)
 #endif
     }
 
+    const QVariant trigramIndex = s.value("trigramIndex");
+    if (trigramIndex.isValid())
+    {
+        m_trigramIndex = trigramIndex.toBool();
+    }
+
+    const QVariant releaseHiddenTabsMinutes = s.value("releaseHiddenTabsMinutes");
+    if (releaseHiddenTabsMinutes.isValid())
+    {
+        m_releaseHiddenTabsMinutes = releaseHiddenTabsMinutes.toInt();
+    }
+
+    const QVariant maxLineLength = s.value("maxLineLength");
+    if (maxLineLength.isValid())
+    {
+        m_maxLineLength = maxLineLength.toInt();
+    }
+
+    m_settingsChanges = 0;
+    if (m_logFont != previousLogFont || m_darkTheme != previousDarkTheme || m_maxLineLength != previousMaxLineLength)
+    {
+        m_settingsChanges |= StyleSettings;
+    }
+    if (m_visibleBlocks != previousVisibleBlocks)
+    {
+        m_settingsChanges |= HistorySettings;
+    }
+    if (m_trigramIndex != previousTrigramIndex)
+    {
+        m_settingsChanges |= IndexSettings;
+    }
+
     const QVariant filterCompletions = s.value("filterCompletions");
     if (filterCompletions.isValid())
     {
@@ -207,6 +250,30 @@ void DeviceFacade::loadSettings(const QSettings& s)
     }
 }
 
+void DeviceFacade::updateThemeFormats()
+{
+    // resolved once per settings load, the log views only index these while painting
+    m_logFont = QFont(m_font, m_fontSize);
+    m_logFont.setBold(m_fontBold);
+
+    for (int i = 0; i < ColorTheme::COLOR_TYPES; ++i)
+    {
+        const auto type = static_cast<ColorTheme::ColorType>(i);
+        const QColor color(m_colorTheme->getColor(type));
+        m_themeFormats[i] = QTextCharFormat();
+        if (type == ColorTheme::Highlight)
+        {
+            // no background suits every column color, so the highlighted text gets its own
+            m_themeFormats[i].setBackground(color);
+            m_themeFormats[i].setForeground(QColor(m_colorTheme->getColor(ColorTheme::HighlightText)));
+        }
+        else
+        {
+            m_themeFormats[i].setForeground(color);
+        }
+    }
+}
+
 void DeviceFacade::saveSettings(QSettings& s)
 {
     qDebug() << "DeviceFacade::saveSettings";
@@ -218,6 +285,9 @@ void DeviceFacade::saveSettings(QSettings& s)
     s.setValue("clearAndroidLog", m_clearAndroidLog);
     s.setValue("autoRemoveFilesHours", m_autoRemoveFilesHours);
     s.setValue("textEditorPath", m_textEditorPath);
+    s.setValue("trigramIndex", m_trigramIndex);
+    s.setValue("releaseHiddenTabsMinutes", m_releaseHiddenTabsMinutes);
+    s.setValue("maxLineLength", m_maxLineLength);
     s.setValue("filterCompletions", m_filterCompletions);
 
     QStringList logFiles;
@@ -388,11 +458,11 @@ void DeviceFacade::onDeviceDisconnected(const DataTypes::DeviceType type, const
     }
 }
 
-void DeviceFacade::allDevicesReloadText()
+void DeviceFacade::allDevicesApplySettings()
 {
     for (auto& device : m_devicesMap)
     {
-        device->reloadTextEdit();
+        device->applySettings(m_settingsChanges);
     }
 }
 
@@ -453,6 +523,16 @@ void DeviceFacade::openLogFile()
     getCurrentDeviceWidget()->openLogFile();
 }
 
+void DeviceFacade::findMatch(const bool backward)
+{
+    qDebug() << "findMatch" << backward;
+    const QPointer<DeviceWidget> deviceWidget = getCurrentDeviceWidget();
+    if (!deviceWidget.isNull())
+    {
+        deviceWidget->findMatch(backward);
+    }
+}
+
 void DeviceFacade::writeToLogFile(const QString& id, const QString& line)
 {
     const auto it = m_devicesMap.find(id);
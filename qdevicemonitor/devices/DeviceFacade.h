@@ -27,6 +27,7 @@
 
 #include <QColor>
 #include <QCompleter>
+#include <QFont>
 #include <QObject>
 #include <QPointer>
 #include <QStandardItemModel>
@@ -34,6 +35,7 @@
 #include <QTimer>
 #include <QSettings>
 #include <QStringList>
+#include <QTextCharFormat>
 #include <QVector>
 
 class DeviceWidget;
@@ -68,14 +70,28 @@ private:
     bool m_fontBold;
     bool m_darkTheme;
     QSharedPointer<ColorTheme> m_colorTheme;
+    QTextCharFormat m_themeFormats[ColorTheme::COLOR_TYPES];
+    QFont m_logFont;
     bool m_clearAndroidLog;
     int m_autoRemoveFilesHours;
     QStandardItemModel m_filterCompleterModel;
     QCompleter m_filterCompleter;
     QStringList m_filterCompletions;
     QString m_textEditorPath;
+    bool m_trigramIndex;
+    int m_releaseHiddenTabsMinutes;
+    int m_maxLineLength;
+    int m_settingsChanges;
 
 public:
+    // what the last loadSettings() changed, so that the devices redo only what depends on it
+    enum SettingsChange
+    {
+        StyleSettings = 1 << 0,
+        HistorySettings = 1 << 1,
+        IndexSettings = 1 << 2
+    };
+
     static const int LOG_REMOVAL_INTERVAL = 30 * 60 * 1000;
     static const int MAX_FILTER_COMPLETIONS = 60;
 
@@ -90,16 +106,19 @@ public:
     void markLog();
     void clearLog();
     void openLogFile();
+    void findMatch(const bool backward);
     void writeToLogFile(const QString& id, const QString& line);
 
     void openTextFileDevice(const QString& fullPath);
 
     void loadSettings(const QSettings& s);
     void saveSettings(QSettings& s);
-    void allDevicesReloadText();
+    void allDevicesApplySettings();
 
     inline bool isDarkTheme() const { return m_darkTheme; }
     inline QColor getThemeColor(const ColorTheme::ColorType type) const { return m_colorTheme->getColor(type); }
+    inline const QTextCharFormat& getThemeFormat(const ColorTheme::ColorType type) const { return m_themeFormats[type]; }
+    inline const QFont& getLogFont() const { return m_logFont; }
     inline bool getClearAndroidLog() const { return m_clearAndroidLog; }
     inline const QString& getFont() const { return m_font; }
     inline int getFontSize() const { return m_fontSize; }
@@ -107,6 +126,9 @@ public:
     inline int getAutoRemoveFilesHours() const { return m_autoRemoveFilesHours; }
     inline int getVisibleLines() const { return m_visibleBlocks; }
     inline const QString& getTextEditorPath() const { return m_textEditorPath; }
+    inline bool isTrigramIndexEnabled() const { return m_trigramIndex; }
+    inline int getReleaseHiddenTabsMinutes() const { return m_releaseHiddenTabsMinutes; }
+    inline int getMaxLineLength() const { return m_maxLineLength; }
 
     inline QCompleter& getFilterCompleter() { return m_filterCompleter; }
     void addFilterAsCompletion(const QString& completionToAdd);
@@ -128,6 +150,7 @@ private slots:
 
 private:
     void fixTabIndexes(const int removedTabIndex);
+    void updateThemeFormats();
     QPointer<DeviceWidget> getCurrentDeviceWidget();
 
     void initTrackersUpdater();
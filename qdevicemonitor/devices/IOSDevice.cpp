@@ -187,8 +187,7 @@ void IOSDevice::stopLogger()
 
 void IOSDevice::onUpdateFilter(const QString& filter)
 {
-    m_filters = filter.split(' ');
-    m_filtersValid = true;
+    setFilters(filter);
     reloadTextEdit();
     maybeAddCompletionAfterDelay(filter);
 }
@@ -225,49 +224,56 @@ void IOSDevice::checkFilters(bool& filtersMatch, bool& filtersValid, const QStri
     }
 }
 
-void IOSDevice::filterAndAddToTextEdit(const QString& line)
+static bool isConnectionStatusLine(const QString& line)
 {
-    if (line == QString("[connected]") || line == QString("[disconnected]"))
-    {
-        m_deviceFacade->emitUsbConnectionChange();
-        return;
-    }
+    return line == QString("[connected]") || line == QString("[disconnected]");
+}
 
+void IOSDevice::parseLine(const QString& line, RecordFields& fields) const
+{
     static const QRegularExpression re(
         "(?<prefix>[A-Za-z]* +[\\d]+ [\\d:]+) (?<deviceName>.+) ",
         QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption
     );
 
-    bool filtersMatch = true;
     const QRegularExpressionMatch match = re.match(line);
     if (match.hasMatch())
     {
-        const QStringRef prefix = match.capturedRef("prefix");
-        const QStringRef deviceName = match.capturedRef("deviceName");
-        const QStringRef text = line.midRef(match.capturedEnd("deviceName") + 1);
+        fields.setColumn(PrefixColumn, match.capturedRef("prefix"));
+        fields.setColumn(DeviceNameColumn, match.capturedRef("deviceName"));
+        fields.setColumn(TextColumn, line.midRef(match.capturedEnd("deviceName") + 1));
+    }
+}
 
-        checkFilters(filtersMatch, m_filtersValid, text);
+bool IOSDevice::matchesFilters(const QString& line, const RecordFields& fields)
+{
+    if (isConnectionStatusLine(line))
+    {
+        return false;
+    }
 
-        if (filtersMatch)
-        {
-            m_deviceWidget->addText(ColorTheme::DateTime, prefix);
-            m_deviceWidget->addText(ColorTheme::VerbosityWarn, deviceName);
-            m_deviceWidget->addText(ColorTheme::VerbosityVerbose, text);
-            m_deviceWidget->flushText();
-        }
+    bool filtersMatch = true;
+    checkFilters(filtersMatch, m_filtersValid, getSearchableText(line, fields));
+    return filtersMatch;
+}
+
+QStringRef IOSDevice::getSearchableText(const QString& line, const RecordFields& fields) const
+{
+    return fields.isParsed() ? fields.getColumn(line, TextColumn) : QStringRef(&line);
+}
+
+void IOSDevice::formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const
+{
+    if (fields.isParsed())
+    {
+        logLine.append(ColorTheme::DateTime, fields.getColumn(line, PrefixColumn));
+        logLine.append(ColorTheme::VerbosityWarn, fields.getColumn(line, DeviceNameColumn));
+        logLine.append(ColorTheme::VerbosityVerbose, fields.getColumn(line, TextColumn));
     }
     else
     {
-        checkFilters(filtersMatch, m_filtersValid, QStringRef(&line));
-
-        if (filtersMatch)
-        {
-            m_deviceWidget->addText(ColorTheme::VerbosityVerbose, QStringRef(&line));
-            m_deviceWidget->flushText();
-        }
+        logLine.append(ColorTheme::VerbosityVerbose, QStringRef(&line));
     }
-
-    m_deviceWidget->highlightFilterLineEdit(!m_filtersValid);
 }
 
 void IOSDevice::reloadTextEdit()
@@ -278,7 +284,7 @@ void IOSDevice::reloadTextEdit()
     }
 
     qDebug() << "reloadTextEdit";
-    m_deviceWidget->clearTextEdit();
+    m_deviceWidget->clearLogView();
 
     updateLogBufferSpace();
     filterAndAddFromLogBufferToTextEdit();
@@ -323,8 +329,7 @@ void IOSDevice::maybeReadErrorsPart()
         if (m_tempErrorsStream.readLineInto(&line))
 #endif
         {
-            m_deviceWidget->addText(ColorTheme::VerbosityAssert, QStringRef(&line));
-            m_deviceWidget->flushText();
+            m_deviceWidget->addLine(ColorTheme::VerbosityAssert, line);
         }
     }
 }
@@ -332,7 +337,7 @@ void IOSDevice::maybeReadErrorsPart()
 void IOSDevice::maybeReadLogPart()
 {
     QString line;
-    for (int i = 0; i < MAX_LINES_UPDATE && m_logProcess.canReadLine(); ++i)
+    for (int i = 0; i < getMaxLinesUpdate() && m_logProcess.canReadLine(); ++i)
     {
         m_tempStream << m_logProcess.readLine();
 #if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
@@ -343,8 +348,13 @@ void IOSDevice::maybeReadLogPart()
         if (m_tempStream.readLineInto(&line))
 #endif
         {
+            if (isConnectionStatusLine(line))
+            {
+                m_deviceFacade->emitUsbConnectionChange();
+            }
+
             writeToLogFile(line);
-            filterAndAddToTextEdit(line);
+            filterAndAddLatestFromLogBufferToTextEdit();
         }
     }
 }
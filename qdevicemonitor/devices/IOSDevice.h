@@ -30,6 +30,13 @@ class IOSDevice : public BaseDevice
 {
     Q_OBJECT
 
+    enum Column
+    {
+        PrefixColumn,
+        DeviceNameColumn,
+        TextColumn
+    };
+
     QProcess m_infoProcess;
     QProcess m_logProcess;
     QFile m_logFile;
@@ -53,7 +60,10 @@ public:
     void writeToLogFile(const QString& line) override;
 
     void onUpdateFilter(const QString& filter) override;
-    void filterAndAddToTextEdit(const QString& line) override;
+    void parseLine(const QString& line, RecordFields& fields) const override;
+    bool matchesFilters(const QString& line, const RecordFields& fields) override;
+    void formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const override;
+    QStringRef getSearchableText(const QString& line, const RecordFields& fields) const override;
     const char* getPlatformName() const override { return "iOS"; }
     void reloadTextEdit() override;
 
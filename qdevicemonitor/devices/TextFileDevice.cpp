@@ -84,8 +84,7 @@ void TextFileDevice::stopLogger()
 
 void TextFileDevice::onUpdateFilter(const QString& filter)
 {
-    m_filters = filter.split(' ');
-    m_filtersValid = true;
+    setFilters(filter);
     reloadTextEdit();
     maybeAddCompletionAfterDelay(filter);
 }
@@ -107,48 +106,52 @@ void TextFileDevice::checkFilters(bool& filtersMatch, bool& filtersValid, const
     }
 }
 
-void TextFileDevice::filterAndAddToTextEdit(const QString& line)
+void TextFileDevice::parseLine(const QString& line, RecordFields& fields) const
 {
     static const QRegularExpression re(
         "(?<prefix>[A-Za-z]{3} +[\\d]{1,2} [\\d:]{8}) (?<hostname>.+) ",
         QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption
     );
 
-    bool filtersMatch = true;
     const QRegularExpressionMatch match = re.match(line);
     if (match.hasMatch())
     {
-        const QStringRef prefix = match.capturedRef("prefix");
-        const QStringRef hostname = match.capturedRef("hostname");
-        const QStringRef text = line.midRef(match.capturedEnd("hostname") + 1);
+        fields.setColumn(PrefixColumn, match.capturedRef("prefix"));
+        fields.setColumn(HostnameColumn, match.capturedRef("hostname"));
+        fields.setColumn(TextColumn, line.midRef(match.capturedEnd("hostname") + 1));
+    }
+}
 
-        checkFilters(filtersMatch, m_filtersValid, text);
+bool TextFileDevice::matchesFilters(const QString& line, const RecordFields& fields)
+{
+    bool filtersMatch = true;
+    checkFilters(filtersMatch, m_filtersValid, getSearchableText(line, fields));
+    return filtersMatch;
+}
 
-        if (filtersMatch)
-        {
-            m_deviceWidget->addText(ColorTheme::DateTime, prefix);
-            m_deviceWidget->addText(ColorTheme::VerbosityWarn, hostname);
-            m_deviceWidget->addText(ColorTheme::VerbosityVerbose, text);
-            m_deviceWidget->flushText();
-        }
+QStringRef TextFileDevice::getSearchableText(const QString& line, const RecordFields& fields) const
+{
+    return fields.isParsed() ? fields.getColumn(line, TextColumn) : QStringRef(&line);
+}
+
+void TextFileDevice::formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const
+{
+    if (fields.isParsed())
+    {
+        logLine.append(ColorTheme::DateTime, fields.getColumn(line, PrefixColumn));
+        logLine.append(ColorTheme::VerbosityWarn, fields.getColumn(line, HostnameColumn));
+        logLine.append(ColorTheme::VerbosityVerbose, fields.getColumn(line, TextColumn));
     }
     else
     {
-        checkFilters(filtersMatch, m_filtersValid, QStringRef(&line));
-        if (filtersMatch)
-        {
-            m_deviceWidget->addText(ColorTheme::VerbosityVerbose, QStringRef(&line));
-            m_deviceWidget->flushText();
-        }
+        logLine.append(ColorTheme::VerbosityVerbose, QStringRef(&line));
     }
-
-    //m_deviceWidget->highlightFilterLineEdit(!m_filtersValid);
 }
 
 void TextFileDevice::reloadTextEdit()
 {
     qDebug() << "reloadTextEdit";
-    m_deviceWidget->clearTextEdit();
+    m_deviceWidget->clearLogView();
 
     updateLogBufferSpace();
     filterAndAddFromLogBufferToTextEdit();
@@ -162,7 +165,7 @@ void TextFileDevice::onLogReady()
     }
 
     QString line;
-    for (int i = 0; i < MAX_LINES_UPDATE && m_tailProcess.canReadLine(); ++i)
+    for (int i = 0; i < getMaxLinesUpdate() && m_tailProcess.canReadLine(); ++i)
     {
         m_tempStream << m_tailProcess.readLine();
 #if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
@@ -172,7 +175,7 @@ void TextFileDevice::onLogReady()
         m_tempStream.readLineInto(&line);
 #endif
         addToLogBuffer(line);
-        filterAndAddToTextEdit(line);
+        filterAndAddLatestFromLogBufferToTextEdit();
     }
 
     if (m_tailProcess.canReadLine())
@@ -29,6 +29,13 @@ class TextFileDevice : public BaseDevice
 {
     Q_OBJECT
 
+    enum Column
+    {
+        PrefixColumn,
+        HostnameColumn,
+        TextColumn
+    };
+
     QProcess m_tailProcess;
     bool m_loggerStarted;
 
@@ -43,7 +50,10 @@ public:
     ~TextFileDevice() override;
 
     void onUpdateFilter(const QString& filter) override;
-    void filterAndAddToTextEdit(const QString& line) override;
+    void parseLine(const QString& line, RecordFields& fields) const override;
+    bool matchesFilters(const QString& line, const RecordFields& fields) override;
+    void formatLine(const QString& line, const RecordFields& fields, LogLine& logLine) const override;
+    QStringRef getSearchableText(const QString& line, const RecordFields& fields) const override;
     const char* getPlatformName() const override { return "Text File"; }
     void reloadTextEdit() override;
 
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT += core gui
+QT += core gui concurrent
 
 QT_VERSION = 5
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
@@ -16,9 +16,18 @@ RESOURCES = resources.qrc
 
 SOURCES += \
     main.cpp \
+    BlockSummaries.cpp \
+    RecordIndex.cpp \
+    TextSearch.cpp \
+    TrigramIndex.cpp \
+    TrigramIndexer.cpp \
+    ValueFilter.cpp \
     Utils.cpp \
     ui/MainWindow.cpp \
     ui/DeviceWidget.cpp \
+    ui/GlyphCache.cpp \
+    ui/LogModel.cpp \
+    ui/LogView.cpp \
     ui/SettingsDialog.cpp \
     ui/colors/ColorTheme.cpp \
     devices/BaseDevice.cpp \
@@ -32,11 +41,27 @@ SOURCES += \
     devices/trackers/usb/TimerUsbTracker.cpp
 
 HEADERS += \
+    BlockSummaries.h \
+    CandidateQuery.h \
     DataTypes.h \
+    KeyIndex.h \
+    LruCache.h \
+    OverloadDetector.h \
+    RecordIdList.h \
+    RecordIndex.h \
+    SearchIndex.h \
     StringRingBuffer.h \
+    TextSearch.h \
+    TrigramIndex.h \
+    TrigramIndexer.h \
+    ValueColumn.h \
+    ValueFilter.h \
     Utils.h \
     ui/MainWindow.h \
     ui/DeviceWidget.h \
+    ui/GlyphCache.h \
+    ui/LogModel.h \
+    ui/LogView.h \
     ui/SettingsDialog.h \
     ui/colors/ColorTheme.h \
     ui/colors/DarkColorTheme.h \
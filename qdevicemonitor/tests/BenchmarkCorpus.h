@@ -0,0 +1,63 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCHMARKCORPUS_H
+#define BENCHMARKCORPUS_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Log-like lines for the benchmarks: a few words out of a small vocabulary and a unique id.
+// The corpus is small by default, set QDEVICEMONITOR_BENCHMARK_LINES=10000000 for a full run.
+class BenchmarkCorpus
+{
+public:
+    static int getLines()
+    {
+        const int lines = qEnvironmentVariableIntValue("QDEVICEMONITOR_BENCHMARK_LINES");
+        return lines > 0 ? lines : 100000;
+    }
+
+    static QString generateLine(const int i)
+    {
+        static const char* const words[] = {
+            "ActivityManager", "Displayed", "started", "service", "connection", "timeout",
+            "bluetooth", "wifi", "sensor", "battery", "surface", "buffer", "queue", "vsync"
+        };
+        static const int wordsCount = sizeof(words) / sizeof(words[0]);
+        return QString("%1 %2 %3 id=%4")
+            .arg(words[i % wordsCount])
+            .arg(words[(i / wordsCount) % wordsCount])
+            .arg(words[(i * 7) % wordsCount])
+            .arg(i);
+    }
+
+    static QVector<QString> generate()
+    {
+        const int lines = getLines();
+        QVector<QString> corpus;
+        corpus.reserve(lines);
+        for (int i = 0; i < lines; ++i)
+        {
+            corpus.append(generateLine(i));
+        }
+        return corpus;
+    }
+};
+
+#endif // BENCHMARKCORPUS_H
@@ -0,0 +1,130 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTBLOCKSUMMARIES_H
+#define TESTBLOCKSUMMARIES_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QString>
+#include "../BlockSummaries.h"
+
+class TestBlockSummaries : public QObject
+{
+    Q_OBJECT
+
+    static const quint64 LINES = 4 * BlockSummaries::BLOCK_SIZE;
+
+    static void fill(BlockSummaries& summaries, const quint64 rareBlock)
+    {
+        const QString common("ActivityManager: Start proc");
+        const QString rare("WindowManager: rare failure");
+        for (quint64 id = 0; id < LINES; ++id)
+        {
+            RecordFields fields;
+            fields.values[RecordFields::PidValue] = static_cast<qint64>(id / BlockSummaries::BLOCK_SIZE * 100);
+            const bool isRare = id == rareBlock * BlockSummaries::BLOCK_SIZE + 7;
+            summaries.add(id, QStringRef(isRare ? &rare : &common), fields);
+        }
+    }
+
+private slots:
+    void testTextLookup()
+    {
+        BlockSummaries summaries(LINES);
+        fill(summaries, 2);
+
+        QVector<BlockSummaries::IdRange> ranges;
+        const QString rare("rare failure");
+        QVERIFY(summaries.findRangesContaining(QStringRef(&rare), 0, LINES, ranges));
+        QCOMPARE(ranges.size(), 1);
+        QCOMPARE(ranges.first().begin, 2 * quint64(BlockSummaries::BLOCK_SIZE));
+        QCOMPARE(ranges.first().end, 3 * quint64(BlockSummaries::BLOCK_SIZE));
+
+        // the trigrams are case folded
+        const QString upperCase("RARE FAILURE");
+        QVERIFY(summaries.findRangesContaining(QStringRef(&upperCase), 0, LINES, ranges));
+        QCOMPARE(ranges.size(), 1);
+
+        const QString common("Start");
+        QVERIFY(summaries.findRangesContaining(QStringRef(&common), 10, LINES - 10, ranges));
+        QCOMPARE(ranges.size(), 1);
+        QCOMPARE(ranges.first().begin, quint64(10));
+        QCOMPARE(ranges.first().end, LINES - 10);
+
+        const QString missing("SurfaceFlinger");
+        QVERIFY(summaries.findRangesContaining(QStringRef(&missing), 0, LINES, ranges));
+        QVERIFY(ranges.isEmpty());
+
+        const QString tooShort("ra");
+        QVERIFY(!summaries.findRangesContaining(QStringRef(&tooShort), 0, LINES, ranges));
+    }
+
+    void testCrowdedBlock()
+    {
+        // a block with too many distinct trigrams isn't summarized and can't be skipped,
+        // the block being filled is looked up exactly
+        BlockSummaries summaries(LINES);
+        const quint64 end = BlockSummaries::BLOCK_SIZE + 1;
+        for (quint64 id = 0; id < end; ++id)
+        {
+            const quint64 h = id * Q_UINT64_C(0x9e3779b97f4a7c15);
+            const QString text = QString::number(h, 36) + QString::number(~h, 36);
+            summaries.add(id, QStringRef(&text), RecordFields());
+        }
+
+        QVector<BlockSummaries::IdRange> ranges;
+        const QString missing("~~~");
+        QVERIFY(summaries.findRangesContaining(QStringRef(&missing), 0, end, ranges));
+        QCOMPARE(ranges.size(), 1);
+        QCOMPARE(ranges.first().begin, quint64(0));
+        QCOMPARE(ranges.first().end, quint64(BlockSummaries::BLOCK_SIZE));
+    }
+
+    void testValueRanges()
+    {
+        BlockSummaries summaries(LINES);
+        fill(summaries, 0);
+
+        QVector<BlockSummaries::IdRange> ranges;
+        summaries.findRangesWithValueIn(RecordFields::PidValue, 150, 250, 0, LINES, ranges);
+        QCOMPARE(ranges.size(), 1);
+        QCOMPARE(ranges.first().begin, 2 * quint64(BlockSummaries::BLOCK_SIZE));
+        QCOMPARE(ranges.first().end, 3 * quint64(BlockSummaries::BLOCK_SIZE));
+
+        summaries.findRangesWithValueIn(RecordFields::TidValue, 0, 1000, 0, LINES, ranges);
+        QVERIFY(ranges.isEmpty());
+    }
+
+    void testOverwrittenBlocks()
+    {
+        // the blocks of the evicted records are reused by the new ones
+        BlockSummaries summaries(BlockSummaries::BLOCK_SIZE);
+        fill(summaries, 0);
+
+        QVector<BlockSummaries::IdRange> ranges;
+        const QString rare("rare failure");
+        QVERIFY(summaries.findRangesContaining(QStringRef(&rare), LINES - BlockSummaries::BLOCK_SIZE, LINES, ranges));
+        QVERIFY(ranges.isEmpty());
+
+        // the blocks which aren't summarized can't be skipped
+        QVERIFY(summaries.findRangesContaining(QStringRef(&rare), 0, BlockSummaries::BLOCK_SIZE, ranges));
+        QCOMPARE(ranges.size(), 1);
+    }
+};
+
+#endif // TESTBLOCKSUMMARIES_H
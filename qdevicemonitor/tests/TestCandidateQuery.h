@@ -0,0 +1,137 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TESTCANDIDATEQUERY_H
+#define TESTCANDIDATEQUERY_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include "../CandidateQuery.h"
+
+class TestCandidateQuery : public QObject
+{
+    Q_OBJECT
+
+    static RecordIdList fromList(std::initializer_list<quint64> ids)
+    {
+        RecordIdList result;
+        for (const quint64 id : ids)
+        {
+            result.append(id);
+        }
+        return result;
+    }
+
+    static QVector<quint64> toVector(const RecordIdList& ids)
+    {
+        QVector<quint64> result;
+        for (const quint64 id : ids)
+        {
+            result.append(id);
+        }
+        return result;
+    }
+
+private slots:
+    void testIntersectRanges()
+    {
+        const QVector<RecordIdRange> a({ { 0, 10 }, { 20, 30 } });
+        const QVector<RecordIdRange> b({ { 5, 25 } });
+        const QVector<RecordIdRange> result = CandidateQuery::intersectRanges(a, b);
+        QCOMPARE(result.size(), 2);
+        QCOMPARE(result[0].begin, quint64(5));
+        QCOMPARE(result[0].end, quint64(10));
+        QCOMPARE(result[1].begin, quint64(20));
+        QCOMPARE(result[1].end, quint64(25));
+    }
+
+    void testValueColumn()
+    {
+        // the ids wrap around the slots and the scans cross the chunks
+        const int chunkSize = ValueColumn::CHUNK_SIZE;
+        const quint64 capacity = chunkSize + 100;
+        ValueColumn values(static_cast<int>(capacity), 0);
+        for (const int slot : { 0, chunkSize - 1, chunkSize, static_cast<int>(capacity) - 1 })
+        {
+            values.set(slot, 7);
+        }
+        QCOMPARE(values.at(chunkSize), qint64(7));
+
+        RecordIdList ids = values.getIdsInRange(5, 10, QVector<RecordIdRange>({ { capacity, 2 * capacity } }));
+        QCOMPARE(toVector(ids), QVector<quint64>({ capacity, capacity + chunkSize - 1, capacity + chunkSize, 2 * capacity - 1 }));
+
+        ids = values.getIdsInRange(5, 10, QVector<RecordIdRange>({ { capacity - 1, capacity + 1 } }));
+        QCOMPARE(toVector(ids), QVector<quint64>({ capacity - 1, capacity }));
+    }
+
+    void testIndexedTerms()
+    {
+        CandidateQuery query;
+        query.firstId = 0;
+        query.endId = 100;
+        query.ranges.append(QVector<RecordIdRange>({ { 10, 20 }, { 40, 50 } }));
+        query.ranges.append(QVector<RecordIdRange>({ { 15, 45 } }));
+
+        // the ranges alone are expanded
+        CandidateQuery::Result result = CandidateQuery::collect(query);
+        QCOMPARE(result.ids.size(), 10);
+        QCOMPARE(result.ids.at(0), quint64(15));
+        QCOMPARE(result.ids.last(), quint64(44));
+        QCOMPARE(result.beginId, quint64(0));
+
+        // the posting lists of a key term are united, the key and value terms are intersected,
+        // then only their ids within the ranges are kept
+        query.keyTerms.append(QVector<RecordIdList>({ fromList({ 3, 30, 60 }), fromList({ 16, 42 }) }));
+        CandidateQuery::ValueTerm valueTerm;
+        valueTerm.values = ValueColumn(100, 0);
+        for (const int slot : { 16, 42, 60 })
+        {
+            valueTerm.values.set(slot, 5);
+        }
+        valueTerm.min = 1;
+        valueTerm.max = 10;
+        valueTerm.ranges.append({ 0, 100 });
+        query.valueTerms.append(valueTerm);
+        result = CandidateQuery::collect(query);
+        QCOMPARE(toVector(result.ids), QVector<quint64>({ 16, 42 }));
+    }
+
+    void testRefinement()
+    {
+        CandidateQuery query;
+        query.firstId = 10;
+        query.endId = 100;
+        query.refinement = true;
+        query.previousCandidates = fromList({ 5, 20, 30, 70 });
+        query.previousCandidateCount = 3;
+        query.previousCandidatesBeginId = 15;
+        query.previousMatches = fromList({ 80, 90 });
+        query.previousMatchedEndId = 97;
+
+        // the previous candidates below the first line are evicted
+        CandidateQuery::Result result = CandidateQuery::collect(query);
+        QCOMPARE(toVector(result.ids), QVector<quint64>({ 20, 30, 80, 90, 97, 98, 99 }));
+        QCOMPARE(result.beginId, quint64(15));
+
+        // the index covers the lines which were never filtered too
+        query.keyTerms.append(QVector<RecordIdList>({ fromList({ 12, 30, 90, 98 }) }));
+        result = CandidateQuery::collect(query);
+        QCOMPARE(toVector(result.ids), QVector<quint64>({ 12, 30, 90, 98 }));
+        QCOMPARE(result.beginId, quint64(10));
+    }
+};
+
+#endif // TESTCANDIDATEQUERY_H
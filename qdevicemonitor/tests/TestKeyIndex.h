@@ -0,0 +1,78 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTKEYINDEX_H
+#define TESTKEYINDEX_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QString>
+#include "../KeyIndex.h"
+
+class TestKeyIndex : public QObject
+{
+    Q_OBJECT
+
+    static void add(KeyIndex& index, const quint64 id, const QString& value)
+    {
+        index.add(id, QStringRef(&value));
+    }
+
+private slots:
+    void testLookup()
+    {
+        KeyIndex index(4);
+        add(index, 0, "ActivityManager");
+        add(index, 1, "WindowManager");
+        add(index, 2, "ActivityManager");
+        add(index, 3, "");
+
+        QCOMPARE(index.getDistinctValues(), 2);
+
+        const QString exact("ActivityManager");
+        const RecordIdList exactIds = index.getIdsContaining(QStringRef(&exact));
+        QCOMPARE(exactIds.size(), 2);
+        QCOMPARE(exactIds.at(0), quint64(0));
+        QCOMPARE(exactIds.at(1), quint64(2));
+
+        const QString substring("Manager");
+        QCOMPARE(index.getIdsContaining(QStringRef(&substring)).size(), 3);
+
+        const QString lowerCase("activitymanager");
+        QVERIFY(index.getIdsContaining(QStringRef(&lowerCase)).isEmpty());
+        QCOMPARE(index.getIdsContaining(QStringRef(&lowerCase), Qt::CaseInsensitive).size(), 2);
+    }
+
+    void testEviction()
+    {
+        KeyIndex index(2);
+        add(index, 0, "a");
+        add(index, 1, "b");
+        add(index, 2, "c");
+        add(index, 3, "c");
+
+        QCOMPARE(index.getDistinctValues(), 1);
+
+        const QString a("a");
+        QCOMPARE(index.getIdsContaining(QStringRef(&a)).isEmpty(), true);
+
+        const QString c("c");
+        QCOMPARE(index.getIdsContaining(QStringRef(&c)).size(), 2);
+    }
+};
+
+#endif
@@ -0,0 +1,226 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTLOGMODEL_H
+#define TESTLOGMODEL_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include "../ui/LogModel.h"
+
+class TestLogModel : public QObject
+{
+    Q_OBJECT
+
+    static LogLine makeLine(const QString& text)
+    {
+        LogLine line;
+        line.append(ColorTheme::VerbosityVerbose, QStringRef(&text));
+        return line;
+    }
+
+private slots:
+    void testLine()
+    {
+        const QString tag("ActivityManager");
+        const QString text("Start proc");
+        LogLine line;
+        line.append(ColorTheme::Tag, QStringRef(&tag));
+        line.append(ColorTheme::VerbosityInfo, QStringRef(&text));
+
+        QCOMPARE(line.text, QString("ActivityManager Start proc "));
+        QCOMPARE(line.segments.size(), 2);
+        QCOMPARE(line.segments[1].position, 16);
+        QCOMPARE(line.segments[1].length, 10);
+        QCOMPARE(line.segments[1].color, ColorTheme::VerbosityInfo);
+    }
+
+    void testLineMaxLength()
+    {
+        const QString tag("ActivityManager");
+        const QString text("Start proc");
+        const QString pid("123");
+        LogLine line;
+        line.clear(20);
+        line.append(ColorTheme::Tag, QStringRef(&tag));
+        line.append(ColorTheme::VerbosityInfo, QStringRef(&text));
+        line.append(ColorTheme::Pid, QStringRef(&pid));
+
+        // the text is cut in the column which runs past the maximum, the columns after it are dropped
+        QCOMPARE(line.text, QString("ActivityManager Star "));
+        QCOMPARE(line.segments.size(), 2);
+        QCOMPARE(line.segments[1].length, 4);
+        QCOMPARE(line.getFullLength(), 30);
+
+        line.clear();
+        QCOMPARE(line.getFullLength(), 0);
+        line.append(ColorTheme::Pid, QStringRef(&pid));
+        QCOMPARE(line.text, QString("123 "));
+        QCOMPARE(line.getFullLength(), 3);
+    }
+
+    void testAppendAndPrepend()
+    {
+        LogModel model(5);
+        QCOMPARE(model.append(10), 0);
+        QCOMPARE(model.append(11), 0);
+
+        // only the newest ids which fit are prepended
+        QCOMPARE(model.prepend(QVector<quint64>({ 3, 5, 7, 9 })), 3);
+        QCOMPARE(model.size(), 5);
+        QCOMPARE(model.at(0), quint64(5));
+        QCOMPARE(model.at(2), quint64(9));
+        QCOMPARE(model.at(4), quint64(11));
+
+        QCOMPARE(model.append(12), 1);
+        QCOMPARE(model.at(0), quint64(7));
+        QCOMPARE(model.at(4), quint64(12));
+
+        QCOMPARE(model.setMaxRows(2), 3);
+        QCOMPARE(model.at(0), quint64(11));
+    }
+
+    void testManyPrepends()
+    {
+        LogModel model;
+        for (quint64 id = 1000; id > 0; id -= 10)
+        {
+            QVector<quint64> ids;
+            for (quint64 i = id - 10; i < id; ++i)
+            {
+                ids.append(i);
+            }
+            model.prepend(ids);
+        }
+
+        QCOMPARE(model.size(), 1000);
+        for (int row = 0; row < model.size(); ++row)
+        {
+            QCOMPARE(model.at(row), quint64(row));
+        }
+
+        // the room left for prepends is freed too
+        model.squeeze();
+        QCOMPARE(model.size(), 1000);
+        QCOMPARE(model.at(0), quint64(0));
+        QCOMPARE(model.at(999), quint64(999));
+    }
+
+    void testClearUpTo()
+    {
+        LogModel model;
+        model.append(10);
+        model.append(11);
+        model.clearUpTo(12);
+        QVERIFY(model.isEmpty());
+
+        // the cleared records don't come back, neither by backfilling nor by reloading
+        QCOMPARE(model.prepend({ 10, 11 }), 0);
+        QVERIFY(model.isEmpty());
+
+        model.append(12);
+        QCOMPARE(model.prepend({ 9, 10, 11 }), 0);
+        QCOMPARE(model.size(), 1);
+
+        model.clear();
+        model.append(13);
+        QCOMPARE(model.prepend({ 10, 11, 12 }), 1);
+        QCOMPARE(model.size(), 2);
+        QCOMPARE(model.at(0), quint64(12));
+        QCOMPARE(model.at(1), quint64(13));
+    }
+
+    void testExtraLines()
+    {
+        LogModel model;
+        model.append(1);
+        model.appendExtraLine(makeLine("mark"));
+        model.append(2);
+        model.append(3);
+
+        QVERIFY(!LogModel::isExtraLine(model.at(0)));
+        QVERIFY(LogModel::isExtraLine(model.at(1)));
+        QCOMPARE(model.getExtraLine(model.at(1)).text, QString("mark "));
+
+        // an extra line is only dropped along with a record after it
+        QCOMPARE(model.trim(2), 1);
+        QVERIFY(LogModel::isExtraLine(model.at(0)));
+        QCOMPARE(model.at(1), quint64(2));
+
+        model.appendExtraLine(makeLine("mark"));
+        QCOMPARE(model.trim(4), 3);
+        QCOMPARE(model.size(), 1);
+        QVERIFY(LogModel::isExtraLine(model.at(0)));
+    }
+
+    void testTrimHead()
+    {
+        LogModel model(4);
+        model.trim(5);
+        model.appendExtraLine(makeLine("mark"));
+        QCOMPARE(model.trim(5), 0);
+        model.append(7);
+        QCOMPARE(model.trim(7), 0);
+        QCOMPARE(model.trim(8), 2);
+        QVERIFY(model.isEmpty());
+
+        // the rows dropped to stay within maxRows change the head too
+        for (const quint64 id : { 10, 11, 12, 13, 14 })
+        {
+            model.append(id);
+        }
+        QCOMPARE(model.trim(11), 0);
+        QCOMPARE(model.trim(12), 1);
+        QCOMPARE(model.at(0), quint64(12));
+
+        model.clear();
+        QCOMPARE(model.prepend(QVector<quint64>({ 3, 4 })), 2);
+        QCOMPARE(model.trim(4), 1);
+        QCOMPARE(model.at(0), quint64(4));
+    }
+
+    void testFindRow()
+    {
+        LogModel model;
+        QCOMPARE(model.findRow(1), -1);
+
+        for (quint64 id = 10; id < 100; id += 10)
+        {
+            model.append(id);
+            if (id % 30 == 0)
+            {
+                model.appendExtraLine(makeLine("mark"));
+                model.appendExtraLine(makeLine("mark"));
+            }
+        }
+
+        for (int row = 0; row < model.size(); ++row)
+        {
+            if (!LogModel::isExtraLine(model.at(row)))
+            {
+                QCOMPARE(model.findRow(model.at(row)), row);
+            }
+        }
+        QCOMPARE(model.findRow(5), -1);
+        QCOMPARE(model.findRow(35), -1);
+        QCOMPARE(model.findRow(100), -1);
+    }
+};
+
+#endif // TESTLOGMODEL_H
@@ -0,0 +1,76 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTLRUCACHE_H
+#define TESTLRUCACHE_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QString>
+#include "../LruCache.h"
+
+class TestLruCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testTake()
+    {
+        LruCache<QString, int> cache(2);
+        cache.insert("a", 1);
+
+        int value = 0;
+        QCOMPARE(cache.take("b", value), false);
+        QCOMPARE(cache.take("a", value), true);
+        QCOMPARE(value, 1);
+        QCOMPARE(cache.size(), 0);
+    }
+
+    void testEviction()
+    {
+        LruCache<QString, int> cache(2);
+        cache.insert("a", 1);
+        cache.insert("b", 2);
+        cache.insert("a", 3);
+        cache.insert("c", 4);
+
+        QCOMPARE(cache.size(), 2);
+
+        int value = 0;
+        QCOMPARE(cache.take("b", value), false);
+        QCOMPARE(cache.take("a", value), true);
+        QCOMPARE(value, 3);
+        QCOMPARE(cache.take("c", value), true);
+        QCOMPARE(value, 4);
+    }
+
+    void testForEachValue()
+    {
+        LruCache<QString, int> cache(2);
+        cache.insert("a", 1);
+        cache.insert("b", 2);
+        cache.forEachValue([](int& value) { value *= 10; });
+
+        int value = 0;
+        QCOMPARE(cache.take("a", value), true);
+        QCOMPARE(value, 10);
+        QCOMPARE(cache.take("b", value), true);
+        QCOMPARE(value, 20);
+    }
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTOVERLOADDETECTOR_H
+#define TESTOVERLOADDETECTOR_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include "../OverloadDetector.h"
+
+class TestOverloadDetector : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testShortBurst()
+    {
+        OverloadDetector detector;
+        for (qint64 now = 0; now < 900; now += 100)
+        {
+            QCOMPARE(detector.update(now, 3000, true), false);
+        }
+        QCOMPARE(detector.update(900, 100, false), false);
+        QCOMPARE(detector.update(1000, 3000, true), false);
+        QVERIFY(!detector.isOverloaded());
+    }
+
+    void testEnterAndLeave()
+    {
+        OverloadDetector detector;
+        qint64 now = 0;
+        for (; now < 1000; now += 100)
+        {
+            QCOMPARE(detector.update(now, 3000, true), false);
+        }
+        QCOMPARE(detector.update(now, 3000, true), true);
+        QVERIFY(detector.isOverloaded());
+        QCOMPARE(detector.getRate(), 33000);
+        QCOMPARE(detector.getRenderRate(), 33000);
+
+        // a single read leaving unread lines keeps the whole window overloaded
+        for (now += 100; now <= 2000; now += 100)
+        {
+            QCOMPARE(detector.update(now, 3000, now == 1500), false);
+        }
+        QVERIFY(detector.isOverloaded());
+        QCOMPARE(detector.getRate(), 30000);
+
+        // all the lines are read, but they still come about as fast as they were rendered
+        for (; now <= 4000; now += 100)
+        {
+            QCOMPARE(detector.update(now, 3000, false), false);
+        }
+        QVERIFY(detector.isOverloaded());
+
+        // the rate drops below half of the rendered one
+        for (; now < 5000; now += 100)
+        {
+            QCOMPARE(detector.update(now, 1000, false), false);
+        }
+        QCOMPARE(detector.update(now, 1000, false), true);
+        QVERIFY(!detector.isOverloaded());
+        QCOMPARE(detector.getRate(), 10000);
+    }
+
+    void testNoFlappingAboveRenderRate()
+    {
+        // the device logs a bit faster than 30 lines/ms can be rendered
+        OverloadDetector detector;
+        qint64 now = 0;
+        for (; now <= 1000; now += 100)
+        {
+            detector.update(now, 3000, true);
+        }
+        QVERIFY(detector.isOverloaded());
+
+        // capturing only, every line is read as it comes
+        for (now += 100; now <= 20000; now += 100)
+        {
+            QCOMPARE(detector.update(now, 3100, false), false);
+        }
+        QVERIFY(detector.isOverloaded());
+        QCOMPARE(detector.getRate(), 31000);
+    }
+
+    void testLeaveWhenQuiet()
+    {
+        OverloadDetector detector;
+        qint64 now = 0;
+        for (; now <= 1000; now += 100)
+        {
+            detector.update(now, 3000, true);
+        }
+        QVERIFY(detector.isOverloaded());
+
+        // the device may not be read at all meanwhile
+        QCOMPARE(detector.update(now + 1000, 0, false), false);
+        QCOMPARE(detector.update(now + 2000, 0, false), true);
+        QVERIFY(!detector.isOverloaded());
+        QCOMPARE(detector.getRate(), 0);
+    }
+};
+
+#endif // TESTOVERLOADDETECTOR_H
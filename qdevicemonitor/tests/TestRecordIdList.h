@@ -0,0 +1,93 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTRECORDIDLIST_H
+#define TESTRECORDIDLIST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include "../RecordIdList.h"
+
+class TestRecordIdList : public QObject
+{
+    Q_OBJECT
+
+    static RecordIdList fromList(std::initializer_list<quint64> ids)
+    {
+        RecordIdList result;
+        for (const quint64 id : ids)
+        {
+            result.append(id);
+        }
+        return result;
+    }
+
+    static QVector<quint64> toVector(const RecordIdList& ids)
+    {
+        QVector<quint64> result;
+        for (const quint64 id : ids)
+        {
+            result.append(id);
+        }
+        return result;
+    }
+
+private slots:
+    void testTrim()
+    {
+        RecordIdList ids = fromList({1, 3, 5, 7});
+        ids.trim(4);
+        QCOMPARE(ids.size(), 2);
+        QCOMPARE(ids.at(0), quint64(5));
+        QCOMPARE(toVector(ids), QVector<quint64>({5, 7}));
+
+        ids.trim(8);
+        QCOMPARE(ids.isEmpty(), true);
+    }
+
+    void testPrepend()
+    {
+        RecordIdList ids = fromList({1, 5, 7});
+        ids.trim(4);
+        ids.prepend(QVector<quint64>({2, 3}));
+        QCOMPARE(toVector(ids), QVector<quint64>({2, 3, 5, 7}));
+
+        ids.prepend(QVector<quint64>());
+        QCOMPARE(ids.size(), 4);
+        ids.append(9);
+        QCOMPARE(ids.last(), quint64(9));
+    }
+
+    void testUnite()
+    {
+        const RecordIdList a = fromList({1, 4, 6});
+        const RecordIdList b = fromList({2, 4, 9});
+        QCOMPARE(toVector(RecordIdList::unite(a, b)), QVector<quint64>({1, 2, 4, 6, 9}));
+        QCOMPARE(toVector(RecordIdList::unite(a, RecordIdList())), QVector<quint64>({1, 4, 6}));
+    }
+
+    void testIntersect()
+    {
+        const RecordIdList a = fromList({1, 4, 6, 8, 10});
+        const RecordIdList b = fromList({4, 10, 11});
+        QCOMPARE(toVector(RecordIdList::intersect(a, b)), QVector<quint64>({4, 10}));
+        QCOMPARE(toVector(RecordIdList::intersect(b, a)), QVector<quint64>({4, 10}));
+        QCOMPARE(RecordIdList::intersect(a, RecordIdList()).isEmpty(), true);
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TESTRECORDINDEX_H
+#define TESTRECORDINDEX_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include "../RecordIndex.h"
+
+class TestRecordIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testPreviousUpToVerbosityLevel()
+    {
+        // records 0 and 1 are evicted by 4 and 5
+        RecordIndex index(4);
+        const DataTypes::VerbosityEnum levels[] = {
+            DataTypes::Error, DataTypes::Verbose, DataTypes::Verbose,
+            DataTypes::Warn, DataTypes::Verbose, DataTypes::Verbose
+        };
+        for (quint64 id = 0; id < 6; ++id)
+        {
+            RecordFields fields;
+            fields.verbosity = levels[id];
+            QStringRef keys[RecordIndex::KEYS];
+            index.add(id, fields, keys);
+        }
+
+        quint64 id = 0;
+        QVERIFY(index.findPreviousUpToVerbosityLevel(DataTypes::Warn, 6, id));
+        QCOMPARE(id, quint64(3));
+        QVERIFY(!index.findPreviousUpToVerbosityLevel(DataTypes::Warn, 3, id));
+        QVERIFY(!index.findPreviousUpToVerbosityLevel(DataTypes::Assert, 6, id));
+
+        QVERIFY(index.findPreviousUpToVerbosityLevel(DataTypes::Verbose, 3, id));
+        QCOMPARE(id, quint64(2));
+        QVERIFY(index.findPreviousUpToVerbosityLevel(DataTypes::Verbose, 6, id));
+        QCOMPARE(id, quint64(5));
+    }
+};
+
+#endif // TESTRECORDINDEX_H
@@ -0,0 +1,134 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTSEARCHINDEX_H
+#define TESTSEARCHINDEX_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "../SearchIndex.h"
+#include "../StringRingBuffer.h"
+#include "../ui/LogModel.h"
+
+#include <limits>
+
+class TestSearchIndex : public QObject
+{
+    Q_OBJECT
+
+    // displays the lines with their columns separated by single spaces, like the devices do
+    class BufferSource : public LogSource
+    {
+        const StringRingBuffer& m_buffer;
+
+    public:
+        explicit BufferSource(const StringRingBuffer& buffer)
+            : m_buffer(buffer)
+        {
+        }
+
+        void formatRecord(const quint64 id, LogLine& line) const override
+        {
+            const QString text = m_buffer.at(id).simplified();
+            line.append(ColorTheme::VerbosityVerbose, QStringRef(&text));
+        }
+    };
+
+    static QVector<quint64> ids(const SearchIndex& index)
+    {
+        QVector<quint64> result;
+        for (const quint64 id : index.getIds())
+        {
+            result.append(id);
+        }
+        return result;
+    }
+
+private slots:
+    void testTermInTagColumn()
+    {
+        StringRingBuffer buffer(8);
+        const BufferSource source(buffer);
+        buffer.push("01-01 10:00:00.000   100   101 I ActivityManager: Start proc");
+        buffer.push("01-01 10:00:00.001   100   101 D NetworkMonitor: probe done");
+        buffer.push("--------- beginning of NetworkMonitor");
+        buffer.push("01-01 10:00:00.002   100   101 D Other: networkmonitor in text");
+
+        // the term is only in the tag column or in an unparsed line, never in a message text
+        SearchIndex index;
+        QCOMPARE(index.setTerms(QStringList("NetworkMonitor"), Qt::CaseSensitive, buffer.getEndId()), true);
+        QVERIFY(!index.isDone(buffer.getFirstId()));
+        index.searchOlder(source, buffer.getFirstId(), std::numeric_limits<int>::max());
+        QVERIFY(index.isDone(buffer.getFirstId()));
+        QCOMPARE(ids(index), QVector<quint64>({ 1, 2 }));
+
+        const quint64 id = buffer.push("01-01 10:00:00.003   100   101 W NetworkMonitor: timeout");
+        index.add(id, source);
+        QCOMPARE(ids(index), QVector<quint64>({ 1, 2, 4 }));
+
+        QCOMPARE(index.setTerms(QStringList("NetworkMonitor"), Qt::CaseSensitive, buffer.getEndId()), false);
+        QCOMPARE(index.setTerms(QStringList("NetworkMonitor"), Qt::CaseInsensitive, buffer.getEndId()), true);
+        QVERIFY(index.getIds().isEmpty());
+        index.searchOlder(source, buffer.getFirstId(), std::numeric_limits<int>::max());
+        QCOMPARE(ids(index), QVector<quint64>({ 1, 2, 3, 4 }));
+    }
+
+    void testEviction()
+    {
+        StringRingBuffer buffer(3);
+        const BufferSource source(buffer);
+        SearchIndex index;
+        index.setTerms(QStringList() << "a" << "b", Qt::CaseSensitive, buffer.getEndId());
+        for (const char* const line : { "a", "x", "b", "a" })
+        {
+            const quint64 id = buffer.push(line);
+            index.add(id, source);
+        }
+        index.trim(buffer.getFirstId());
+        QCOMPARE(ids(index), QVector<quint64>({ 2, 3 }));
+
+        // the lines evicted before being searched are skipped
+        index.restart(buffer.getEndId());
+        for (const char* const line : { "b", "x" })
+        {
+            const quint64 id = buffer.push(line);
+            index.add(id, source);
+        }
+        index.searchOlder(source, buffer.getFirstId(), std::numeric_limits<int>::max());
+        QCOMPARE(ids(index), QVector<quint64>({ 3, 4 }));
+        QVERIFY(index.isDone(buffer.getFirstId()));
+    }
+
+    void testFormattedText()
+    {
+        StringRingBuffer buffer(4);
+        const BufferSource source(buffer);
+        buffer.push("01-01 10:00:00.000   100   101 I ActivityManager: Start proc");
+        buffer.push("01-01 10:00:00.001  1100   101 I ActivityManager: Start proc");
+
+        // the columns are searched as they're displayed, not as they're read
+        SearchIndex index;
+        index.setTerms(QStringList(" 100 101 "), Qt::CaseSensitive, buffer.getEndId());
+        index.searchOlder(source, buffer.getFirstId(), std::numeric_limits<int>::max());
+        QCOMPARE(ids(index), QVector<quint64>({ 0 }));
+    }
+};
+
+#endif // TESTSEARCHINDEX_H
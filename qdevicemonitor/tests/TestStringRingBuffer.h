@@ -69,6 +69,53 @@ private slots:
         it++;
         QCOMPARE(it.isValid(), false);
     }
+
+    void testIds()
+    {
+        StringRingBuffer buf(2);
+        QCOMPARE(buf.getFirstId(), quint64(0));
+        QCOMPARE(buf.getEndId(), quint64(0));
+
+        QCOMPARE(buf.push("a"), quint64(0));
+        QCOMPARE(buf.push("b"), quint64(1));
+        QCOMPARE(buf.push("c"), quint64(2));
+        QCOMPARE(buf.getFirstId(), quint64(1));
+        QCOMPARE(buf.getEndId(), quint64(3));
+        QCOMPARE(buf.contains(0), false);
+        QCOMPARE(buf.at(1), QString("b"));
+        QCOMPARE(buf.at(2), QString("c"));
+
+        auto it = buf.constBegin();
+        QCOMPARE(it.getId(), quint64(1));
+        it++;
+        QCOMPARE(it.getId(), quint64(2));
+    }
+
+    void testSetCapacity()
+    {
+        StringRingBuffer buf(3);
+        buf.push("a");
+        buf.push("b");
+        buf.push("c");
+        buf.push("d");
+
+        buf.setCapacity(2);
+        QCOMPARE(buf.getCapacity(), size_t(2));
+        QCOMPARE(buf.getFirstId(), quint64(2));
+        QCOMPARE(buf.getEndId(), quint64(4));
+        QCOMPARE(buf.at(2), QString("c"));
+        QCOMPARE(buf.at(3), QString("d"));
+
+        buf.setCapacity(4);
+        QCOMPARE(buf.getFirstId(), quint64(2));
+        QCOMPARE(buf.push("e"), quint64(4));
+        QCOMPARE(buf.push("f"), quint64(5));
+        QCOMPARE(buf.getFirstId(), quint64(2));
+        QCOMPARE(buf.push("g"), quint64(6));
+        QCOMPARE(buf.getFirstId(), quint64(3));
+        QCOMPARE(buf.at(3), QString("d"));
+        QCOMPARE(buf.at(6), QString("g"));
+    }
 };
 
 #endif
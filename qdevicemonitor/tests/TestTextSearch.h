@@ -0,0 +1,147 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTTEXTSEARCH_H
+#define TESTTEXTSEARCH_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+#include "BenchmarkCorpus.h"
+#include "../TextSearch.h"
+
+class TestTextSearch : public QObject
+{
+    Q_OBJECT
+
+    static bool contains(const QString& text, const QString& term)
+    {
+        return TextSearch::contains(QStringRef(&text), QStringRef(&term), Qt::CaseInsensitive);
+    }
+
+private slots:
+    void testIsAscii()
+    {
+        const QString ascii("ActivityManager: Displayed com.example/.MainActivity");
+        QVERIFY(TextSearch::isAscii(ascii.unicode(), ascii.length()));
+
+        for (int i = 0; i < 20; ++i)
+        {
+            QString text(20, 'a');
+            text[i] = QChar(0xe9);
+            QVERIFY(!TextSearch::isAscii(text.unicode(), text.length()));
+        }
+    }
+
+    void testAsciiSearch()
+    {
+        const QString text("ActivityManager: Displayed com.example/.MainActivity: +1s201ms");
+        QVERIFY(contains(text, "activitymanager"));
+        QVERIFY(contains(text, "MAINACTIVITY"));
+        QVERIFY(contains(text, "+1S201MS"));
+        QVERIFY(contains(text, "a"));
+        QVERIFY(contains(text, ""));
+        QVERIFY(!contains(text, "windowmanager"));
+        QVERIFY(!contains(text, "activity manager"));
+        QVERIFY(!contains("short", "longer than the text"));
+
+        // the term at every position, around the vectorized blocks and the scalar tail
+        for (int i = 0; i < 40; ++i)
+        {
+            QString line(40, '.');
+            line.replace(i, 1, "X");
+            QCOMPARE(TextSearch::indexOfIgnoringAsciiCase(line.unicode(), line.length(), QString("x").unicode(), 1), i);
+
+            line = QString(40, '.');
+            line.insert(i, "WiFi");
+            QCOMPARE(TextSearch::indexOfIgnoringAsciiCase(line.unicode(), line.length(), QString("wifi").unicode(), 4), i);
+        }
+
+        // only letters are folded
+        QVERIFY(!contains("[", "{"));
+        QVERIFY(!contains("@", "`"));
+    }
+
+    void testUnicodeSearch()
+    {
+        QVERIFY(contains(QString::fromUtf8("\xc3\x84pfel"), QString::fromUtf8("\xc3\xa4PFEL")));
+        QVERIFY(!contains(QString::fromUtf8("\xc3\x84pfel"), "apfel"));
+
+        // the Kelvin sign folds to an ASCII letter
+        QVERIFY(contains(QString::fromUtf8("300 \xe2\x84\xaa"), "300 k"));
+    }
+
+    void testCaseSensitiveSearch()
+    {
+        const QString text("ActivityManager");
+        const QString term("activity");
+        QVERIFY(!TextSearch::contains(QStringRef(&text), QStringRef(&term), Qt::CaseSensitive));
+        QVERIFY(TextSearch::contains(QStringRef(&text), QStringRef(&term), Qt::CaseInsensitive));
+    }
+
+    void benchmarkQStringContains()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const QString term("CONNECTION TIMEOUT");
+        int matches = 0;
+        QBENCHMARK
+        {
+            matches = 0;
+            for (const QString& line : corpus)
+            {
+                matches += line.contains(term, Qt::CaseInsensitive) ? 1 : 0;
+            }
+        }
+        QVERIFY(matches > 0);
+    }
+
+    void benchmarkRegexp()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const QRegularExpression re(".*(CONNECTION TIMEOUT).*", QRegularExpression::DotMatchesEverythingOption | QRegularExpression::CaseInsensitiveOption);
+        int matches = 0;
+        QBENCHMARK
+        {
+            matches = 0;
+            for (const QString& line : corpus)
+            {
+                matches += re.match(line).hasMatch() ? 1 : 0;
+            }
+        }
+        QVERIFY(matches > 0);
+    }
+
+    void benchmarkTextSearch()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const QString term("CONNECTION TIMEOUT");
+        int matches = 0;
+        QBENCHMARK
+        {
+            matches = 0;
+            for (const QString& line : corpus)
+            {
+                matches += TextSearch::contains(QStringRef(&line), QStringRef(&term), Qt::CaseInsensitive) ? 1 : 0;
+            }
+        }
+        QVERIFY(matches > 0);
+    }
+};
+
+#endif // TESTTEXTSEARCH_H
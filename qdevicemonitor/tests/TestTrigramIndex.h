@@ -0,0 +1,158 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTTRIGRAMINDEX_H
+#define TESTTRIGRAMINDEX_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include "BenchmarkCorpus.h"
+#include "../TrigramIndex.h"
+
+class TestTrigramIndex : public QObject
+{
+    Q_OBJECT
+
+    static void addBlock(TrigramIndex& index, const quint64 block, const QStringList& lines)
+    {
+        QVector<TrigramIndex::Text> texts;
+        for (const QString& line : lines)
+        {
+            texts.append({ line, 0, line.length() });
+        }
+        index.addBlock(block, TrigramIndex::extractTrigrams(texts));
+    }
+
+    static QVector<quint64> findCandidateBlocks(const TrigramIndex& index, const QString& term)
+    {
+        QVector<quint64> blocks;
+        if (!index.findCandidateBlocks(QStringRef(&term), blocks))
+        {
+            blocks.append(~quint64(0));
+        }
+        return blocks;
+    }
+
+private slots:
+    void testLookup()
+    {
+        TrigramIndex index(1024 * 1024);
+        addBlock(index, 0, QStringList() << "hello world" << "foo");
+        addBlock(index, 1, QStringList() << "world peace");
+        addBlock(index, 2, QStringList() << "nothing here");
+
+        QCOMPARE(findCandidateBlocks(index, "world"), QVector<quint64>() << 0 << 1);
+        QCOMPARE(findCandidateBlocks(index, "hello"), QVector<quint64>() << 0);
+        QCOMPARE(findCandidateBlocks(index, "absent"), QVector<quint64>());
+        QCOMPARE(findCandidateBlocks(index, "wo"), QVector<quint64>() << ~quint64(0));
+    }
+
+    void testEviction()
+    {
+        TrigramIndex index(1024 * 1024);
+        addBlock(index, 0, QStringList() << "first");
+        addBlock(index, 1, QStringList() << "second");
+        addBlock(index, 2, QStringList() << "third first");
+
+        index.evict(TrigramIndex::BLOCK_SIZE * 2);
+        QCOMPARE(index.getFirstBlock(), quint64(2));
+        QCOMPARE(findCandidateBlocks(index, "first"), QVector<quint64>() << 2);
+        QCOMPARE(findCandidateBlocks(index, "second"), QVector<quint64>());
+
+        index.evict(TrigramIndex::BLOCK_SIZE * 4);
+        QCOMPARE(index.getEndBlock(), quint64(4));
+        QCOMPARE(index.getMemoryUsage(), size_t(0));
+    }
+
+    void testMissingBlock()
+    {
+        TrigramIndex index(1024 * 1024);
+        addBlock(index, 0, QStringList() << "first");
+        addBlock(index, 2, QStringList() << "third");
+
+        QCOMPARE(index.getFirstBlock(), quint64(2));
+        QCOMPARE(findCandidateBlocks(index, "first"), QVector<quint64>());
+    }
+
+    void testMemoryBudget()
+    {
+        TrigramIndex index(4096);
+        for (int block = 0; block < 64; ++block)
+        {
+            addBlock(index, block, QStringList() << BenchmarkCorpus::generateLine(block) << QString::number(block * 1000));
+        }
+
+        QVERIFY(index.getMemoryUsage() <= 4096);
+        QVERIFY(index.getFirstBlock() > 0);
+        QCOMPARE(index.getEndBlock(), quint64(64));
+    }
+
+    void benchmarkScan()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const QString term(QString("id=%1").arg(corpus.size() / 2));
+        int matches = 0;
+        QBENCHMARK
+        {
+            matches = 0;
+            for (const QString& line : corpus)
+            {
+                matches += line.contains(term) ? 1 : 0;
+            }
+        }
+        QVERIFY(matches > 0);
+    }
+
+    void benchmarkIndex()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const int lines = corpus.size();
+        TrigramIndex index(size_t(1024) * 1024 * 1024);
+        QVector<TrigramIndex::Text> texts;
+        for (int i = 0; i < lines; ++i)
+        {
+            texts.append({ corpus[i], 0, corpus[i].length() });
+            if (texts.size() == TrigramIndex::BLOCK_SIZE)
+            {
+                index.addBlock(static_cast<quint64>(i / TrigramIndex::BLOCK_SIZE), TrigramIndex::extractTrigrams(texts));
+                texts.clear();
+            }
+        }
+
+        const QString term(QString("id=%1").arg(lines / 2));
+        int matches = 0;
+        QBENCHMARK
+        {
+            matches = 0;
+            QVector<quint64> blocks;
+            QVERIFY(index.findCandidateBlocks(QStringRef(&term), blocks));
+            for (const quint64 block : blocks)
+            {
+                const int end = qMin(lines, static_cast<int>(block + 1) * TrigramIndex::BLOCK_SIZE);
+                for (int i = static_cast<int>(block) * TrigramIndex::BLOCK_SIZE; i < end; ++i)
+                {
+                    matches += corpus[i].contains(term) ? 1 : 0;
+                }
+            }
+        }
+        QVERIFY(matches > 0);
+    }
+};
+
+#endif
@@ -0,0 +1,107 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTVALUEFILTER_H
+#define TESTVALUEFILTER_H
+
+#include <QtTest/QtTest>
+#include <QDateTime>
+#include <QObject>
+#include <QString>
+#include "../ValueFilter.h"
+
+class TestValueFilter : public QObject
+{
+    Q_OBJECT
+
+    static RecordFields makeFields(const RecordFields::Value value, const qint64 x)
+    {
+        RecordFields fields;
+        fields.values[value] = x;
+        return fields;
+    }
+
+private slots:
+    void testIntegerRanges()
+    {
+        const ValueFilter range = ValueFilter::parse("pid:1200-1300");
+        QVERIFY(range.isValid());
+        QCOMPARE(range.getValue(), RecordFields::PidValue);
+        QVERIFY(range.matches(makeFields(RecordFields::PidValue, 1200)));
+        QVERIFY(range.matches(makeFields(RecordFields::PidValue, 1300)));
+        QVERIFY(!range.matches(makeFields(RecordFields::PidValue, 1301)));
+        QVERIFY(!range.matches(RecordFields()));
+
+        const ValueFilter exact = ValueFilter::parse("tid:=4567");
+        QVERIFY(exact.isValid());
+        QCOMPARE(exact.getValue(), RecordFields::TidValue);
+        QVERIFY(exact.matches(makeFields(RecordFields::TidValue, 4567)));
+        QVERIFY(!exact.matches(makeFields(RecordFields::TidValue, 45678)));
+
+        QVERIFY(ValueFilter::parse("pid:>100").matches(makeFields(RecordFields::PidValue, 101)));
+        QVERIFY(!ValueFilter::parse("pid:>100").matches(makeFields(RecordFields::PidValue, 100)));
+        QVERIFY(ValueFilter::parse("pid:<=100").matches(makeFields(RecordFields::PidValue, 100)));
+    }
+
+    void testSubstringFilters()
+    {
+        QVERIFY(!ValueFilter::parse("pid:12").isValid());
+        QVERIFY(!ValueFilter::parse("pid:").isValid());
+        QVERIFY(!ValueFilter::parse("pid:1x-2").isValid());
+        QVERIFY(!ValueFilter::parse("tag:1-2").isValid());
+        QVERIFY(!ValueFilter::parse("1-2").isValid());
+    }
+
+    void testTime()
+    {
+        qint64 msecs = 0;
+        qint64 precision = 0;
+        const QString time("12:03:00.123");
+        QVERIFY(ValueFilter::parseTime(QStringRef(&time), msecs, precision));
+        QCOMPARE(msecs, qint64((12 * 60 + 3) * 60 * 1000 + 123));
+        QCOMPARE(precision, qint64(1));
+
+        const QString hours("12");
+        QVERIFY(!ValueFilter::parseTime(QStringRef(&hours), msecs, precision));
+
+        const ValueFilter after = ValueFilter::parse("time:>12:03:00");
+        QVERIFY(after.isValid());
+        QVERIFY(!after.matches(makeFields(RecordFields::TimeValue, (12 * 60 + 3) * 60 * 1000 + 999)));
+        QVERIFY(after.matches(makeFields(RecordFields::TimeValue, (12 * 60 + 3) * 60 * 1000 + 1000)));
+
+        const ValueFilter minute = ValueFilter::parse("time:12:03");
+        QVERIFY(minute.matches(makeFields(RecordFields::TimeValue, (12 * 60 + 3) * 60 * 1000 + 59999)));
+        QVERIFY(!minute.matches(makeFields(RecordFields::TimeValue, (12 * 60 + 4) * 60 * 1000)));
+    }
+
+    void testSince()
+    {
+        const QDateTime now(QDate(2018, 3, 1), QTime(0, 2));
+        const ValueFilter since = ValueFilter::parse("since:-5m", now);
+        QVERIFY(since.isValid());
+        QCOMPARE(since.getValue(), RecordFields::TimestampValue);
+
+        const qint64 before = RecordFields::makeTimestamp(2, 28, (23 * 60 + 56) * 60 * 1000);
+        const qint64 after = RecordFields::makeTimestamp(2, 28, (23 * 60 + 58) * 60 * 1000);
+        QVERIFY(!since.matches(makeFields(RecordFields::TimestampValue, before)));
+        QVERIFY(since.matches(makeFields(RecordFields::TimestampValue, after)));
+
+        QVERIFY(!ValueFilter::parse("since:5x", now).isValid());
+    }
+};
+
+#endif
@@ -15,5 +15,65 @@
     along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "TestBlockSummaries.h"
+#include "TestCandidateQuery.h"
+#include "TestKeyIndex.h"
+#include "TestLogModel.h"
+#include "TestLruCache.h"
+#include "TestOverloadDetector.h"
+#include "TestRecordIdList.h"
+#include "TestRecordIndex.h"
+#include "TestSearchIndex.h"
 #include "TestStringRingBuffer.h"
-QTEST_MAIN(TestStringRingBuffer)
+#include "TestTextSearch.h"
+#include "TestTrigramIndex.h"
+#include "TestValueFilter.h"
+
+#include <QCoreApplication>
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    int status = 0;
+
+    TestStringRingBuffer testStringRingBuffer;
+    status |= QTest::qExec(&testStringRingBuffer, argc, argv);
+
+    TestRecordIdList testRecordIdList;
+    status |= QTest::qExec(&testRecordIdList, argc, argv);
+
+    TestRecordIndex testRecordIndex;
+    status |= QTest::qExec(&testRecordIndex, argc, argv);
+
+    TestKeyIndex testKeyIndex;
+    status |= QTest::qExec(&testKeyIndex, argc, argv);
+
+    TestLruCache testLruCache;
+    status |= QTest::qExec(&testLruCache, argc, argv);
+
+    TestTrigramIndex testTrigramIndex;
+    status |= QTest::qExec(&testTrigramIndex, argc, argv);
+
+    TestValueFilter testValueFilter;
+    status |= QTest::qExec(&testValueFilter, argc, argv);
+
+    TestBlockSummaries testBlockSummaries;
+    status |= QTest::qExec(&testBlockSummaries, argc, argv);
+
+    TestCandidateQuery testCandidateQuery;
+    status |= QTest::qExec(&testCandidateQuery, argc, argv);
+
+    TestTextSearch testTextSearch;
+    status |= QTest::qExec(&testTextSearch, argc, argv);
+
+    TestLogModel testLogModel;
+    status |= QTest::qExec(&testLogModel, argc, argv);
+
+    TestOverloadDetector testOverloadDetector;
+    status |= QTest::qExec(&testOverloadDetector, argc, argv);
+
+    TestSearchIndex testSearchIndex;
+    status |= QTest::qExec(&testSearchIndex, argc, argv);
+
+    return status;
+}
@@ -1,14 +1,46 @@
 QT += core testlib
 TEMPLATE = app
 TARGET = tests
-INCLUDEPATH += .
+INCLUDEPATH += . ..
 CONFIG += c++11 debug
 QT_VERSION = 5
 QMAKE_CXXFLAGS += -O0
 
 HEADERS += \
+    BenchmarkCorpus.h \
+    TestBlockSummaries.h \
+    TestCandidateQuery.h \
+    TestKeyIndex.h \
+    TestLogModel.h \
+    TestLruCache.h \
+    TestOverloadDetector.h \
+    TestRecordIdList.h \
+    TestRecordIndex.h \
+    TestSearchIndex.h \
     TestStringRingBuffer.h \
-    ../StringRingBuffer.h
+    TestTextSearch.h \
+    TestTrigramIndex.h \
+    TestValueFilter.h \
+    ../BlockSummaries.h \
+    ../CandidateQuery.h \
+    ../KeyIndex.h \
+    ../LruCache.h \
+    ../OverloadDetector.h \
+    ../RecordIdList.h \
+    ../RecordIndex.h \
+    ../SearchIndex.h \
+    ../StringRingBuffer.h \
+    ../TextSearch.h \
+    ../TrigramIndex.h \
+    ../ValueColumn.h \
+    ../ValueFilter.h \
+    ../ui/LogModel.h
 
 SOURCES += \
-    tests.cpp
+    tests.cpp \
+    ../BlockSummaries.cpp \
+    ../RecordIndex.cpp \
+    ../TextSearch.cpp \
+    ../TrigramIndex.cpp \
+    ../ValueFilter.cpp \
+    ../ui/LogModel.cpp
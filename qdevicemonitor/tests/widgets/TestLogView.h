@@ -0,0 +1,124 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTLOGVIEW_H
+#define TESTLOGVIEW_H
+
+#include <QtTest/QtTest>
+#include <QFontDatabase>
+#include <QObject>
+#include <QScrollBar>
+#include <QString>
+#include <QVector>
+#include "BenchmarkCorpus.h"
+#include "../../ui/LogView.h"
+
+class TestLogView : public QObject
+{
+    Q_OBJECT
+
+    static const int VIEW_WIDTH = 1200;
+    static const int VIEW_HEIGHT = 800;
+    static const int MAX_APPENDED_ROWS = 10000;
+
+    // formats the records as the devices do: the first word as a tag, the rest as the text
+    class CorpusSource : public LogSource
+    {
+        const QVector<QString>& m_corpus;
+
+    public:
+        explicit CorpusSource(const QVector<QString>& corpus)
+            : m_corpus(corpus)
+        {
+        }
+
+        void formatRecord(const quint64 id, LogLine& line) const override
+        {
+            const QString& text = m_corpus[static_cast<int>(id % static_cast<quint64>(m_corpus.size()))];
+            const int tagLength = text.indexOf(' ');
+            line.append(ColorTheme::Tag, text.leftRef(tagLength));
+            line.append(ColorTheme::VerbosityInfo, text.midRef(tagLength + 1));
+        }
+    };
+
+    static void setUpView(LogView& view, const LogSource& source, const int maxRows)
+    {
+        view.setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        view.setSource(&source);
+        view.setMaxRows(maxRows);
+        view.resize(VIEW_WIDTH, VIEW_HEIGHT);
+        view.show();
+    }
+
+private slots:
+    void benchmarkScrollRepaint()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const CorpusSource source(corpus);
+        LogView view;
+        setUpView(view, source, corpus.size());
+
+        QVector<quint64> ids;
+        ids.reserve(corpus.size());
+        for (int i = 0; i < corpus.size(); ++i)
+        {
+            ids.append(static_cast<quint64>(i));
+        }
+        view.prependRecords(ids);
+        QCOMPARE(view.getModel().size(), corpus.size());
+
+        // a page up and down, the same rows are painted again and again
+        QScrollBar& sb = *view.verticalScrollBar();
+        const int page = view.getVisibleLineCount();
+        QBENCHMARK
+        {
+            for (int step = 0; step < page; ++step)
+            {
+                sb.setValue(sb.maximum() - step);
+                view.viewport()->repaint();
+            }
+            for (int step = page; step > 0; --step)
+            {
+                sb.setValue(sb.maximum() - step);
+                view.viewport()->repaint();
+            }
+        }
+    }
+
+    void benchmarkAppend()
+    {
+        const QVector<QString> corpus = BenchmarkCorpus::generate();
+        const CorpusSource source(corpus);
+        LogView view;
+        setUpView(view, source, MAX_APPENDED_ROWS);
+
+        // a frame's worth of records at a time, each frame scrolled to the end and painted
+        quint64 id = 0;
+        QBENCHMARK
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                view.appendRecord(id++);
+            }
+            QMetaObject::invokeMethod(&view, "flushPendingRows");
+            view.viewport()->repaint();
+        }
+        QVERIFY(view.isAtEnd());
+    }
+};
+
+#endif // TESTLOGVIEW_H
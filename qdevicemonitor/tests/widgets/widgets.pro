@@ -0,0 +1,20 @@
+QT += core gui widgets testlib
+TEMPLATE = app
+TARGET = widgets
+INCLUDEPATH += . .. ../..
+CONFIG += c++11 debug
+QT_VERSION = 5
+
+HEADERS += \
+    TestLogView.h \
+    ../BenchmarkCorpus.h \
+    ../../LruCache.h \
+    ../../ui/GlyphCache.h \
+    ../../ui/LogModel.h \
+    ../../ui/LogView.h
+
+SOURCES += \
+    widgets.cpp \
+    ../../ui/GlyphCache.cpp \
+    ../../ui/LogModel.cpp \
+    ../../ui/LogView.cpp
@@ -20,8 +20,8 @@
 #include "ui/colors/ColorTheme.h"
 
 #include <QDebug>
+#include <QFont>
 #include <QProcess>
-#include <QScrollBar>
 
 using namespace DataTypes;
 
@@ -31,24 +31,21 @@ DeviceWidget::DeviceWidget(QPointer<QWidget> parent, QPointer<DeviceFacade> devi
     : QWidget(parent)
     , m_deviceFacade(deviceFacade)
     , m_id(id)
+    , m_filterHighlighted(false)
 {
     m_ui = QSharedPointer<Ui::DeviceWidget>::create();
     m_ui->setupUi(this);
 
-    m_defaultTextEditPalette = m_ui->textEdit->palette();
+    m_defaultTextEditPalette = m_ui->logView->palette();
     m_redPalette = QPalette(Qt::red);
     m_redPalette.setColor(QPalette::Highlight, Qt::red);
 
-    m_textStream.setCodec("UTF-8");
-    m_textStream.setString(&m_stringStream, QIODevice::ReadWrite | QIODevice::Text);
+    m_ui->logView->setDeviceFacade(m_deviceFacade);
+    m_ui->logView->setWrap(m_ui->wrapCheckBox->isChecked());
 
-    //ui->textEdit->setFontFamily(m_deviceFacade->getFont());
-    //ui->textEdit->setFontPointSize(m_deviceFacade->getFontSize());
-    m_ui->textEdit->setAttribute(Qt::WA_OpaquePaintEvent);
-    m_ui->textEdit->setUndoRedoEnabled(false);
-    m_ui->textEdit->document()->setMaximumBlockCount(m_deviceFacade->getVisibleLines());
+    clearLogView();
 
-    clearTextEdit();
+    connect(m_ui->logView, &LogView::scrolledToTop, this, &DeviceWidget::scrolledToTop);
 
     m_ui->verbositySlider->valueChanged(m_ui->verbositySlider->value());
     m_ui->wrapCheckBox->setCheckState(m_ui->wrapCheckBox->isChecked() ? Qt::Checked : Qt::Unchecked);
@@ -75,62 +72,77 @@ void DeviceWidget::on_verbositySlider_valueChanged(const int value)
 
 void DeviceWidget::on_wrapCheckBox_toggled(const bool checked)
 {
-    m_ui->textEdit->setLineWrapMode(checked ? QTextEdit::WidgetWidth : QTextEdit::NoWrap);
-    maybeScrollTextEditToEnd();
+    m_ui->logView->setWrap(checked);
+    maybeScrollLogViewToEnd();
 }
 
-void DeviceWidget::on_scrollLockCheckBox_toggled(const bool)
+void DeviceWidget::on_scrollLockCheckBox_toggled(const bool checked)
 {
-    maybeScrollTextEditToEnd();
+    m_ui->logView->setScrollLock(checked);
+    maybeScrollLogViewToEnd();
+}
+
+void DeviceWidget::on_caseInsensitiveCheckBox_toggled(const bool checked)
+{
+    qDebug() << "caseInsensitive" << checked;
+    emit caseSensitivityChanged(checked ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    updateHighlightTerms();
+}
+
+void DeviceWidget::on_highlightLineEdit_textChanged(const QString& text)
+{
+    qDebug() << "highlight" << text;
+    updateHighlightTerms();
+}
+
+void DeviceWidget::updateHighlightTerms()
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+    const QStringList terms = m_ui->highlightLineEdit->text().split(' ', QString::SkipEmptyParts);
+#else
+    const QStringList terms = m_ui->highlightLineEdit->text().split(' ', Qt::SkipEmptyParts);
+#endif
+    const Qt::CaseSensitivity cs = m_ui->caseInsensitiveCheckBox->isChecked() ? Qt::CaseInsensitive : Qt::CaseSensitive;
+    m_ui->logView->setHighlightTerms(terms, cs);
+    emit highlightTermsChanged(terms, cs);
 }
 
 void DeviceWidget::highlightFilterLineEdit(const bool red)
 {
-    m_ui->filterLineEdit->setPalette(red ? m_redPalette : m_defaultTextEditPalette);
+    // it's called for every line, while the palette seldom changes
+    if (red != m_filterHighlighted)
+    {
+        m_filterHighlighted = red;
+        m_ui->filterLineEdit->setPalette(red ? m_redPalette : m_defaultTextEditPalette);
+    }
 }
 
-void DeviceWidget::maybeScrollTextEditToEnd()
+void DeviceWidget::maybeScrollLogViewToEnd()
 {
     if (!m_ui->scrollLockCheckBox->isChecked())
     {
-        scrollTextEditToEnd();
+        m_ui->logView->scrollToEnd();
     }
 }
 
-void DeviceWidget::addText(const ColorTheme::ColorType color, const QStringRef& text)
+void DeviceWidget::addRecord(const quint64 id)
 {
-    addText(m_deviceFacade->getThemeColor(color), text);
+    m_ui->logView->appendRecord(id);
 }
 
-void DeviceWidget::addText(const QColor& color, const QStringRef& text)
+void DeviceWidget::prependRecords(const QVector<quint64>& ids)
 {
-    m_textStream
-        << "<font style=\"font-family: " << m_deviceFacade->getFont()
-        << "; font-size: " << m_deviceFacade->getFontSize()
-        << "pt; font-weight: " << (m_deviceFacade->isFontBold() ? "bold" : "none")
-        << ";\" color=\"" << color.name()
-        << "\">"
-#if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
-        // FIXME: remove this hack
-        << text.toString()
-#else
-        << text
-#endif
-        << " </font>";
+    m_ui->logView->prependRecords(ids);
 }
 
-void DeviceWidget::flushText()
+void DeviceWidget::addLine(const ColorTheme::ColorType color, const QString& text)
 {
-    m_textStream.flush();
-    m_ui->textEdit->setUpdatesEnabled(false);
-
-    m_ui->textEdit->append(m_textStream.readAll());
-    maybeScrollTextEditToEnd();
-
-    m_ui->textEdit->setUpdatesEnabled(true);
+    LogLine line;
+    line.append(color, QStringRef(&text));
+    m_ui->logView->appendExtraLine(line);
 }
 
-void DeviceWidget::updateTextEditPalette()
+void DeviceWidget::updateLogViewPalette()
 {
     QPalette pal;
     if (m_deviceFacade->isDarkTheme())
@@ -142,22 +154,28 @@ void DeviceWidget::updateTextEditPalette()
     {
         pal = m_defaultTextEditPalette;
     }
-    m_ui->textEdit->setPalette(pal);
+    m_ui->logView->setPalette(pal);
 }
 
-void DeviceWidget::clearTextEdit()
+void DeviceWidget::clearLogView()
 {
-    updateTextEditPalette();
-    getTextEdit().clear();
+    restyleLogView();
+    m_ui->logView->setMaxRows(m_deviceFacade->getVisibleLines());
+    m_ui->logView->clear();
 }
 
-void DeviceWidget::scrollTextEditToEnd()
+void DeviceWidget::restyleLogView()
 {
-    QScrollBar& sb = *(getTextEdit().verticalScrollBar());
-    if (sb.maximum() > 0)
-    {
-        sb.setValue(sb.maximum());
-    }
+    // the rows are kept, they're formatted with the current theme whenever they're painted
+    updateLogViewPalette();
+    m_ui->logView->setFont(m_deviceFacade->getLogFont());
+    m_ui->logView->setMaxLineLength(m_deviceFacade->getMaxLineLength());
+    m_ui->logView->viewport()->update();
+}
+
+void DeviceWidget::releaseLogView()
+{
+    m_ui->logView->release();
 }
 
 void DeviceWidget::on_openLogFileButton_clicked()
@@ -187,9 +205,8 @@ void DeviceWidget::focusFilterInput()
 
 void DeviceWidget::on_markLogButton_clicked()
 {
-    addText(ColorTheme::VerbosityVerbose, QStringRef(&MARK_LINE));
+    addLine(ColorTheme::VerbosityVerbose, MARK_LINE);
     m_deviceFacade->writeToLogFile(m_id, MARK_LINE);
-    flushText();
 }
 
 void DeviceWidget::markLog()
@@ -197,6 +214,12 @@ void DeviceWidget::markLog()
     m_ui->markLogButton->click();
 }
 
+void DeviceWidget::on_clearLogButton_clicked()
+{
+    // the device clears the view, it knows which records mustn't be backfilled again
+    emit clearLogRequested();
+}
+
 void DeviceWidget::clearLog()
 {
     m_ui->clearLogButton->click();
@@ -206,3 +229,8 @@ void DeviceWidget::openLogFile()
 {
     m_ui->openLogFileButton->click();
 }
+
+void DeviceWidget::findMatch(const bool backward)
+{
+    emit findMatchRequested(backward);
+}
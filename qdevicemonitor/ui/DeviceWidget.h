@@ -20,12 +20,14 @@
 
 #include "ui_DeviceWidget.h"
 #include "devices/DeviceFacade.h"
+#include "ui/LogView.h"
 #include "ui/colors/ColorTheme.h"
 
 #include <QPalette>
 #include <QPointer>
 #include <QSharedPointer>
-#include <QTextStream>
+#include <QStringList>
+#include <QVector>
 #include <QWidget>
 
 namespace Ui {
@@ -41,9 +43,8 @@ class DeviceWidget : public QWidget
     QPalette m_redPalette;
     QPointer<DeviceFacade> m_deviceFacade;
     QString m_id;
-    QTextStream m_textStream;
-    QString m_stringStream;
     QString m_currentLogFileName;
+    bool m_filterHighlighted;
 
 public:
     explicit DeviceWidget(QPointer<QWidget> parent, QPointer<DeviceFacade> deviceFacade, const QString& id);
@@ -51,33 +52,45 @@ public:
     void hideVerbosity();
 
     inline QLineEdit& getFilterLineEdit() const { return *(m_ui->filterLineEdit); }
-    inline QTextEdit& getTextEdit() const { return *(m_ui->textEdit); }
+    inline LogView& getLogView() const { return *(m_ui->logView); }
     inline int getVerbosityLevel() const { return m_ui->verbositySlider->value(); }
+    inline int getVisibleLineCount() const { return m_ui->logView->getVisibleLineCount(); }
     void highlightFilterLineEdit(bool red);
-    void maybeScrollTextEditToEnd();
-    void addText(const ColorTheme::ColorType color, const QStringRef& text);
-    void addText(const QColor& color, const QStringRef& text);
-    void flushText();
-    void clearTextEdit();
+    void maybeScrollLogViewToEnd();
+    void addRecord(const quint64 id);
+    void prependRecords(const QVector<quint64>& ids);
+    void addLine(const ColorTheme::ColorType color, const QString& text);
+    void clearLogView();
+    void restyleLogView();
+    void releaseLogView();
     void onLogFileNameChanged(const QString& logFileName);
     void focusFilterInput();
     void markLog();
     void clearLog();
     void openLogFile();
+    void findMatch(const bool backward);
 
 signals:
     void verbosityLevelChanged(const int level);
+    void scrolledToTop();
+    void caseSensitivityChanged(const Qt::CaseSensitivity cs);
+    void highlightTermsChanged(const QStringList& terms, const Qt::CaseSensitivity cs);
+    void findMatchRequested(const bool backward);
+    void clearLogRequested();
 
 public slots:
     void on_verbositySlider_valueChanged(const int value);
     void on_wrapCheckBox_toggled(const bool checked);
     void on_scrollLockCheckBox_toggled(const bool checked);
+    void on_caseInsensitiveCheckBox_toggled(const bool checked);
+    void on_highlightLineEdit_textChanged(const QString& text);
     void on_openLogFileButton_clicked();
     void on_markLogButton_clicked();
+    void on_clearLogButton_clicked();
 
 private:
-    void updateTextEditPalette();
-    void scrollTextEditToEnd();
+    void updateLogViewPalette();
+    void updateHighlightTerms();
 };
 
 #endif // DEVICEWIDGET_H
@@ -0,0 +1,101 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GlyphCache.h"
+
+#include <QDebug>
+#include <QFontInfo>
+
+GlyphCache::GlyphCache()
+    : m_advance(0.0)
+    , m_ascent(0.0)
+    , m_valid(false)
+{
+}
+
+void GlyphCache::setFont(const QFont& font)
+{
+    m_valid = false;
+    m_glyphs.clear();
+    m_rawFont = QRawFont::fromFont(font);
+    if (!m_rawFont.isValid() || !QFontInfo(font).fixedPitch())
+    {
+        qDebug() << "no glyph cache for" << font.family();
+        return;
+    }
+
+    QString chars;
+    for (ushort c = FIRST_CHAR; c <= LAST_CHAR; ++c)
+    {
+        chars.append(QChar(c));
+    }
+    m_glyphs = m_rawFont.glyphIndexesForString(chars);
+    if (m_glyphs.size() != chars.size())
+    {
+        return;
+    }
+
+    const QVector<QPointF> advances = m_rawFont.advancesForGlyphIndexes(m_glyphs);
+    for (int i = 0; i < m_glyphs.size(); ++i)
+    {
+        // a missing glyph would need a fallback font, which only the text layout resolves
+        if (m_glyphs[i] == 0 || advances[i].x() != advances[0].x())
+        {
+            qDebug() << "no glyph cache for" << font.family();
+            return;
+        }
+    }
+
+    m_advance = advances[0].x();
+    m_ascent = m_rawFont.ascent();
+    m_valid = m_advance > 0.0;
+}
+
+bool GlyphCache::canDraw(const QString& text) const
+{
+    if (!m_valid)
+    {
+        return false;
+    }
+
+    const QChar* const end = text.constData() + text.size();
+    for (const QChar* c = text.constData(); c != end; ++c)
+    {
+        if (c->unicode() < FIRST_CHAR || c->unicode() > LAST_CHAR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QGlyphRun GlyphCache::createGlyphRun(const QStringRef& text, const qreal x) const
+{
+    QVector<quint32> glyphs(text.size());
+    QVector<QPointF> positions(text.size());
+    for (int i = 0; i < text.size(); ++i)
+    {
+        glyphs[i] = m_glyphs[text.at(i).unicode() - FIRST_CHAR];
+        positions[i] = QPointF(x + i * m_advance, m_ascent);
+    }
+
+    QGlyphRun run;
+    run.setRawFont(m_rawFont);
+    run.setGlyphIndexes(glyphs);
+    run.setPositions(positions);
+    return run;
+}
@@ -0,0 +1,59 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLYPHCACHE_H
+#define GLYPHCACHE_H
+
+#include <QFont>
+#include <QGlyphRun>
+#include <QPointF>
+#include <QRawFont>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+// Glyphs of the printable ASCII characters of a monospace font, shaped once per font.
+// Lines made only of them are turned into glyph runs by table lookups, without text layout.
+class GlyphCache
+{
+public:
+    static const ushort FIRST_CHAR = 0x20;
+    static const ushort LAST_CHAR = 0x7e;
+
+private:
+    QRawFont m_rawFont;
+    QVector<quint32> m_glyphs;
+    qreal m_advance;
+    qreal m_ascent;
+    bool m_valid;
+
+public:
+    GlyphCache();
+
+    void setFont(const QFont& font);
+
+    inline bool isValid() const { return m_valid; }
+    inline qreal getAdvance() const { return m_advance; }
+    inline qreal getTextWidth(const int length) const { return length * m_advance; }
+
+    bool canDraw(const QString& text) const;
+
+    // the text must be drawable, x is the position of its first character
+    QGlyphRun createGlyphRun(const QStringRef& text, const qreal x) const;
+};
+
+#endif // GLYPHCACHE_H
@@ -0,0 +1,231 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogModel.h"
+
+#include <algorithm>
+
+static const int MIN_COMPACTED_ROWS = 1024;
+
+LogModel::LogModel(const int maxRows)
+    : m_begin(0)
+    , m_maxRows(qMax(1, maxRows))
+    , m_nextExtraLine(EXTRA_LINE)
+    , m_clearedEndId(0)
+    , m_headId(NO_HEAD)
+    , m_headKnown(true)
+{
+}
+
+const LogLine& LogModel::getExtraLine(const quint64 id) const
+{
+    static const LogLine emptyLine;
+    const auto it = m_extraLines.constFind(id);
+    return it != m_extraLines.constEnd() ? *it : emptyLine;
+}
+
+int LogModel::findRow(const quint64 id) const
+{
+    int low = 0;
+    int high = size();
+    while (low < high)
+    {
+        const int middle = low + (high - low) / 2;
+        int row = middle;
+        while (row < high && isExtraLine(at(row)))
+        {
+            ++row;
+        }
+
+        if (row == high)
+        {
+            high = middle;
+        }
+        else if (at(row) < id)
+        {
+            low = row + 1;
+        }
+        else if (at(row) > id)
+        {
+            high = middle;
+        }
+        else
+        {
+            return row;
+        }
+    }
+    return -1;
+}
+
+int LogModel::append(const quint64 id)
+{
+    const int removed = size() >= m_maxRows ? size() - m_maxRows + 1 : 0;
+    removeFront(removed);
+
+    // the rows dropped from the front are reused as room for prepending,
+    // they're compacted once they outnumber the rows
+    if (m_begin > qMax(size(), MIN_COMPACTED_ROWS))
+    {
+        m_rows.remove(0, m_begin);
+        m_begin = 0;
+    }
+
+    m_rows.append(id);
+    if (m_headKnown && m_headId == NO_HEAD && !isExtraLine(id))
+    {
+        m_headId = id;
+    }
+    return removed;
+}
+
+int LogModel::appendExtraLine(const LogLine& line)
+{
+    const quint64 id = m_nextExtraLine++;
+    m_extraLines.insert(id, line);
+    return append(id);
+}
+
+int LogModel::setMaxRows(const int maxRows)
+{
+    m_maxRows = qMax(1, maxRows);
+    const int removed = qMax(0, size() - m_maxRows);
+    removeFront(removed);
+    return removed;
+}
+
+int LogModel::prepend(const QVector<quint64>& ids)
+{
+    const int newIds = static_cast<int>(ids.constEnd() - std::lower_bound(ids.constBegin(), ids.constEnd(), m_clearedEndId));
+    const int count = qMin(newIds, m_maxRows - size());
+    if (count <= 0)
+    {
+        return 0;
+    }
+
+    if (count > m_begin)
+    {
+        // the room in front grows with the rows, so prepending is amortized O(1)
+        const int room = count + size();
+        QVector<quint64> rows(room + size());
+        std::copy(m_rows.constBegin() + m_begin, m_rows.constEnd(), rows.begin() + room);
+        m_rows = rows;
+        m_begin = room;
+    }
+
+    m_begin -= count;
+    std::copy(ids.constEnd() - count, ids.constEnd(), m_rows.begin() + m_begin);
+    m_headId = at(0);
+    m_headKnown = true;
+    return count;
+}
+
+int LogModel::trim(const quint64 firstId)
+{
+    // it's called for every line pushed, but the rows are only walked once the head record is evicted
+    if (firstId <= getHeadId())
+    {
+        return 0;
+    }
+
+    int removed = 0;
+    quint64 headId = NO_HEAD;
+    for (int row = 0; row < size(); ++row)
+    {
+        const quint64 id = at(row);
+        if (isExtraLine(id))
+        {
+            continue;
+        }
+        else if (id < firstId)
+        {
+            removed = row + 1;
+        }
+        else
+        {
+            headId = id;
+            break;
+        }
+    }
+
+    removeFront(removed);
+    m_headId = headId;
+    m_headKnown = true;
+    return removed;
+}
+
+void LogModel::clear()
+{
+    m_rows.clear();
+    m_begin = 0;
+    m_extraLines.clear();
+    m_headId = NO_HEAD;
+    m_headKnown = true;
+}
+
+void LogModel::clearUpTo(const quint64 endId)
+{
+    clear();
+    m_clearedEndId = qMax(m_clearedEndId, endId);
+}
+
+void LogModel::squeeze()
+{
+    if (m_begin > 0)
+    {
+        m_rows.remove(0, m_begin);
+        m_begin = 0;
+    }
+    m_rows.squeeze();
+    m_extraLines.squeeze();
+}
+
+void LogModel::removeFront(const int count)
+{
+    if (!m_extraLines.isEmpty())
+    {
+        for (int row = 0; row < count; ++row)
+        {
+            if (isExtraLine(at(row)))
+            {
+                m_extraLines.remove(at(row));
+            }
+        }
+    }
+    m_begin += count;
+    if (count > 0)
+    {
+        m_headKnown = false;
+    }
+}
+
+quint64 LogModel::getHeadId()
+{
+    if (!m_headKnown)
+    {
+        m_headId = NO_HEAD;
+        for (int row = 0; row < size(); ++row)
+        {
+            if (!isExtraLine(at(row)))
+            {
+                m_headId = at(row);
+                break;
+            }
+        }
+        m_headKnown = true;
+    }
+    return m_headId;
+}
@@ -0,0 +1,144 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGMODEL_H
+#define LOGMODEL_H
+
+#include "ui/colors/ColorTheme.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+#include <limits>
+
+// A line as it's displayed: columns separated by spaces, each one with its own color.
+// With maxLength set, the text is only built up to it, though fullLength counts every column.
+struct LogLine
+{
+    struct Segment
+    {
+        int position;
+        int length;
+        ColorTheme::ColorType color;
+    };
+
+    QString text;
+    QVector<Segment> segments;
+    int maxLength;
+    int fullLength;
+
+    LogLine()
+        : maxLength(0)
+        , fullLength(0)
+    {
+    }
+
+    void clear(const int maxLength = 0)
+    {
+        text.clear();
+        segments.clear();
+        this->maxLength = maxLength;
+        fullLength = 0;
+    }
+
+    void append(const ColorTheme::ColorType color, const QStringRef& segment)
+    {
+        fullLength += segment.length() + 1;
+        const int position = text.length();
+        const int length = maxLength > 0 ? qMin(segment.length(), maxLength - position) : segment.length();
+        if (length >= 0)
+        {
+            segments.append({ position, length, color });
+            text.append(segment.left(length));
+            text.append(' ');
+        }
+    }
+
+    // the length of the whole line, without the space after the last column
+    inline int getFullLength() const { return qMax(0, fullLength - 1); }
+};
+
+// Formats the records of a LogModel when they're displayed.
+class LogSource
+{
+public:
+    virtual void formatRecord(const quint64 id, LogLine& line) const = 0;
+
+    virtual ~LogSource()
+    {
+    }
+};
+
+// Rows of a LogView: StringRingBuffer record ids and a few extra lines which
+// aren't records, like marks. Records are formatted by a LogSource only when
+// they're displayed, so a row costs as much as its id.
+class LogModel
+{
+public:
+    static const quint64 EXTRA_LINE = Q_UINT64_C(1) << 63;
+
+private:
+    QVector<quint64> m_rows;
+    int m_begin;
+    int m_maxRows;
+    QHash<quint64, LogLine> m_extraLines;
+    quint64 m_nextExtraLine;
+    quint64 m_clearedEndId;
+    quint64 m_headId;
+    bool m_headKnown;
+
+public:
+    explicit LogModel(const int maxRows = std::numeric_limits<int>::max());
+
+    inline int size() const { return m_rows.size() - m_begin; }
+    inline bool isEmpty() const { return size() == 0; }
+    inline quint64 at(const int row) const { return m_rows[m_begin + row]; }
+    inline int getMaxRows() const { return m_maxRows; }
+    static inline bool isExtraLine(const quint64 id) { return (id & EXTRA_LINE) != 0; }
+    const LogLine& getExtraLine(const quint64 id) const;
+
+    // binary searches the records, skipping the extra lines; returns -1 if the id isn't a row
+    int findRow(const quint64 id) const;
+
+    // these return the count of rows dropped from the front to stay within maxRows
+    int append(const quint64 id);
+    int appendExtraLine(const LogLine& line);
+    int setMaxRows(const int maxRows);
+
+    // ids must be ascending and older than the first row; only the newest ones
+    // which fit into maxRows and weren't cleared are added, returns their count
+    int prepend(const QVector<quint64>& ids);
+
+    // drops the records older than firstId and the extra lines between them
+    int trim(const quint64 firstId);
+    void clear();
+
+    // clears the rows, and the records older than endId are never prepended again
+    void clearUpTo(const quint64 endId);
+    void squeeze();
+
+private:
+    void removeFront(const int count);
+
+    // the id of the first record, past the extra lines in front of it; NO_HEAD without records
+    static const quint64 NO_HEAD = std::numeric_limits<quint64>::max();
+    quint64 getHeadId();
+};
+
+#endif // LOGMODEL_H
@@ -0,0 +1,939 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogView.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QFontMetrics>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <QStringList>
+#include <QTextOption>
+#include <QtMath>
+
+#include <algorithm>
+#include <limits>
+
+LogView::LogView(QWidget* parent)
+    : QAbstractScrollArea(parent)
+    , m_firstId(0)
+    , m_scrollLock(false)
+    , m_newLineCount(0)
+    , m_source(nullptr)
+    , m_wrap(true)
+    , m_maxLineWidth(0)
+    , m_maxLineLength(0)
+    , m_selectionAnchor(-1)
+    , m_selectionEnd(-1)
+    , m_rowHeightsCache(ROW_HEIGHTS_CACHE_SIZE)
+    , m_highlightCaseSensitivity(Qt::CaseSensitive)
+{
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
+    m_glyphCache.setFont(font());
+
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    m_frameTimer.setInterval(FRAME_INTERVAL);
+
+    m_newLinesButton.setParent(viewport());
+    m_newLinesButton.setCursor(Qt::ArrowCursor);
+    m_newLinesButton.setFocusPolicy(Qt::NoFocus);
+    m_newLinesButton.hide();
+
+    m_banner.setParent(viewport());
+    m_banner.setAutoFillBackground(true);
+    m_banner.setBackgroundRole(QPalette::ToolTipBase);
+    m_banner.setForegroundRole(QPalette::ToolTipText);
+    m_banner.setAlignment(Qt::AlignCenter);
+    m_banner.hide();
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &LogView::onScrolled);
+    connect(&m_frameTimer, &QTimer::timeout, this, &LogView::flushPendingRows);
+    connect(&m_newLinesButton, &QPushButton::clicked, this, &LogView::showNewLines);
+}
+
+void LogView::setWrap(const bool wrap)
+{
+    m_wrap = wrap;
+    updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::setMaxRows(const int maxRows)
+{
+    removeRows(m_model.setMaxRows(maxRows));
+    updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::setMaxLineLength(const int maxLineLength)
+{
+    if (maxLineLength != m_maxLineLength)
+    {
+        m_maxLineLength = maxLineLength;
+        m_rowHeights.clear();
+        m_rowHeightsCache.clear();
+        m_glyphRows.clear();
+        m_highlights.clear();
+        m_maxLineWidth = 0;
+        updateScrollBars();
+        viewport()->update();
+    }
+}
+
+void LogView::setScrollLock(const bool scrollLock)
+{
+    m_scrollLock = scrollLock;
+    if (!scrollLock && !m_pendingRows.isEmpty())
+    {
+        appendPendingRows();
+    }
+}
+
+void LogView::appendRecord(const quint64 id)
+{
+    m_pendingRows.append(id);
+    ++m_newLineCount;
+    if (!m_frameTimer.isActive())
+    {
+        m_frameTimer.start();
+    }
+}
+
+void LogView::appendExtraLine(const LogLine& line)
+{
+    appendPendingRows();
+    removeRows(m_model.appendExtraLine(line));
+    updateScrollBars();
+    maybeScrollToEnd();
+    viewport()->update();
+}
+
+void LogView::flushPendingRows()
+{
+    m_frameTimer.stop();
+    if (!isPaused())
+    {
+        appendPendingRows();
+        return;
+    }
+
+    // the rows being read aren't pushed out by new ones; only the newest
+    // pending rows would be kept by the model anyway
+    const int maxRows = m_model.getMaxRows();
+    if (m_pendingRows.size() > 2 * maxRows)
+    {
+        m_pendingRows.remove(0, m_pendingRows.size() - maxRows);
+    }
+    updateNewLinesButton();
+}
+
+void LogView::showNewLines()
+{
+    appendPendingRows();
+    scrollToEnd();
+}
+
+void LogView::appendPendingRows()
+{
+    m_frameTimer.stop();
+    if (m_pendingRows.isEmpty())
+    {
+        return;
+    }
+
+    // the records evicted since they were appended are skipped
+    int removed = 0;
+    for (const quint64 id : m_pendingRows)
+    {
+        if (id >= m_firstId)
+        {
+            removed += m_model.append(id);
+        }
+    }
+    m_pendingRows.clear();
+    m_newLineCount = 0;
+    updateNewLinesButton();
+
+    removeRows(removed);
+    updateScrollBars();
+    maybeScrollToEnd();
+    viewport()->update();
+}
+
+void LogView::updateNewLinesButton()
+{
+    if (m_pendingRows.isEmpty() || !isPaused())
+    {
+        m_newLinesButton.hide();
+        return;
+    }
+
+    m_newLinesButton.setText(tr("%1 new lines").arg(m_newLineCount));
+    m_newLinesButton.adjustSize();
+    m_newLinesButton.move(
+        viewport()->width() - m_newLinesButton.width() - NEW_LINES_BUTTON_MARGIN,
+        viewport()->height() - m_newLinesButton.height() - NEW_LINES_BUTTON_MARGIN
+    );
+    m_newLinesButton.show();
+}
+
+void LogView::maybeScrollToEnd()
+{
+    if (!m_scrollLock)
+    {
+        scrollToEnd();
+    }
+}
+
+void LogView::prependRecords(const QVector<quint64>& ids)
+{
+    const bool atEnd = isAtEnd();
+    const int count = m_model.prepend(ids);
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (m_selectionAnchor >= 0)
+    {
+        m_selectionAnchor += count;
+        m_selectionEnd += count;
+    }
+
+    updateScrollBars();
+
+    // keep the same rows in the viewport
+    QScrollBar& sb = *verticalScrollBar();
+    sb.setValue(atEnd ? sb.maximum() : sb.value() + count);
+    viewport()->update();
+}
+
+void LogView::trim(const quint64 firstId)
+{
+    m_firstId = firstId;
+    const int removed = m_model.trim(firstId);
+    if (removed > 0)
+    {
+        removeRows(removed);
+        for (auto it = m_expandedRows.begin(); it != m_expandedRows.end();)
+        {
+            it = *it < firstId ? m_expandedRows.erase(it) : it + 1;
+        }
+        updateScrollBars();
+        viewport()->update();
+    }
+}
+
+void LogView::clear()
+{
+    m_frameTimer.stop();
+    m_pendingRows.clear();
+    m_newLineCount = 0;
+    updateNewLinesButton();
+    m_model.clear();
+    m_rowHeights.clear();
+    m_rowHeightsCache.clear();
+    m_glyphRows.clear();
+    m_highlights.clear();
+    m_expandedRows.clear();
+    m_maxLineWidth = 0;
+    m_selectionAnchor = -1;
+    m_selectionEnd = -1;
+    updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::clearUpTo(const quint64 endId)
+{
+    clear();
+    m_model.clearUpTo(endId);
+}
+
+void LogView::release()
+{
+    clear();
+    m_model.squeeze();
+    m_pendingRows.squeeze();
+    m_rowHeights.squeeze();
+    m_glyphRows.squeeze();
+    m_highlights.squeeze();
+    m_expandedRows.squeeze();
+    m_paintedRowBottoms.clear();
+    m_paintedRowBottoms.squeeze();
+    m_line = LogLine();
+}
+
+void LogView::setHighlightTerms(const QStringList& terms, const Qt::CaseSensitivity cs)
+{
+    m_highlightTerms = terms;
+    m_highlightTerms.removeAll(QString());
+    m_highlightCaseSensitivity = cs;
+    m_highlights.clear();
+    viewport()->update();
+}
+
+void LogView::setBanner(const QString& text)
+{
+    if (text != m_banner.text())
+    {
+        m_banner.setText(text);
+        updateBanner();
+    }
+}
+
+void LogView::updateBanner()
+{
+    if (m_banner.text().isEmpty())
+    {
+        m_banner.hide();
+        return;
+    }
+
+    m_banner.setGeometry(0, 0, viewport()->width(), m_banner.sizeHint().height());
+    m_banner.show();
+}
+
+bool LogView::isAtEnd() const
+{
+    const QScrollBar& sb = *verticalScrollBar();
+    return sb.value() >= sb.maximum();
+}
+
+bool LogView::isPaused() const
+{
+    return m_scrollLock || !isAtEnd();
+}
+
+void LogView::scrollToEnd()
+{
+    QScrollBar& sb = *verticalScrollBar();
+    sb.setValue(sb.maximum());
+}
+
+void LogView::selectRow(const int row)
+{
+    m_selectionAnchor = row;
+    m_selectionEnd = row;
+
+    // a row out of the screen is brought to its middle
+    QScrollBar& sb = *verticalScrollBar();
+    const int visibleLines = getVisibleLineCount();
+    if (row < sb.value() || row >= sb.value() + visibleLines - 1)
+    {
+        sb.setValue(row - visibleLines / 2);
+    }
+    viewport()->update();
+}
+
+int LogView::getVisibleLineCount() const
+{
+    return viewport()->height() / getLineSpacing() + 1;
+}
+
+int LogView::getLineSpacing() const
+{
+    return qMax(1, QFontMetrics(font()).lineSpacing());
+}
+
+static void truncateLine(LogLine& line, const int length, const QString& marker)
+{
+    line.text.truncate(length);
+    line.text.append(' ');
+
+    int segments = 0;
+    while (segments < line.segments.size() && line.segments[segments].position < length)
+    {
+        LogLine::Segment& segment = line.segments[segments++];
+        segment.length = qMin(segment.length, length - segment.position);
+    }
+    line.segments.resize(segments);
+
+    // the marker isn't a column of the line, so the full length stays the line's
+    line.segments.append({ line.text.length(), marker.length(), ColorTheme::VerbosityVerbose });
+    line.text.append(marker);
+    line.text.append(' ');
+}
+
+const LogLine& LogView::formatRow(const int row, const bool truncate) const
+{
+    const quint64 id = m_model.at(row);
+    if (LogModel::isExtraLine(id))
+    {
+        return m_model.getExtraLine(id);
+    }
+
+    // the rest is only formatted and laid out once the row is expanded
+    const bool truncated = truncate && m_maxLineLength > 0 && !m_expandedRows.contains(id);
+    m_line.clear(truncated ? m_maxLineLength : 0);
+    if (m_source != nullptr)
+    {
+        m_source->formatRecord(id, m_line);
+    }
+
+    const int hiddenLength = m_line.getFullLength() - m_maxLineLength;
+    if (truncated && hiddenLength > 0)
+    {
+        truncateLine(m_line, m_maxLineLength, tr("... [%n more character(s), double-click to expand]", nullptr, hiddenLength));
+    }
+    return m_line;
+}
+
+void LogView::expandRow(const int row)
+{
+    const quint64 id = m_model.at(row);
+    if (LogModel::isExtraLine(id) || m_maxLineLength <= 0 || m_expandedRows.contains(id)
+        || formatRow(row).getFullLength() <= m_maxLineLength)
+    {
+        return;
+    }
+
+    m_expandedRows.insert(id);
+    m_rowHeights.remove(id);
+    m_rowHeightsCache.forEachValue([id](QHash<quint64, int>& rowHeights) {
+        rowHeights.remove(id);
+    });
+    m_glyphRows.remove(id);
+    m_highlights.remove(id);
+    updateScrollBars();
+    viewport()->update();
+}
+
+const QVector<LogLine::Segment>& LogView::getHighlights(const int row, const LogLine& line)
+{
+    static const QVector<LogLine::Segment> noHighlights;
+    if (m_highlightTerms.isEmpty())
+    {
+        return noHighlights;
+    }
+
+    const quint64 id = m_model.at(row);
+    const auto it = m_highlights.constFind(id);
+    if (it != m_highlights.constEnd())
+    {
+        return *it;
+    }
+
+    // the marker of a truncated row isn't searched, so no match runs past the cut
+    const bool truncated = !LogModel::isExtraLine(id) && m_maxLineLength > 0
+        && line.getFullLength() > m_maxLineLength && !m_expandedRows.contains(id);
+    const QStringRef text = truncated ? line.text.leftRef(m_maxLineLength) : QStringRef(&line.text);
+
+    QVector<LogLine::Segment> highlights;
+    for (const QString& term : m_highlightTerms)
+    {
+        for (int position = 0; (position = text.indexOf(term, position, m_highlightCaseSensitivity)) >= 0; position += term.size())
+        {
+            highlights.append({ position, term.size(), ColorTheme::Highlight });
+        }
+    }
+
+    if (m_highlights.size() >= MAX_CACHED_HIGHLIGHTS)
+    {
+        m_highlights.clear();
+    }
+    return *m_highlights.insert(id, highlights);
+}
+
+void LogView::layoutLine(const LogLine& line, QTextLayout& layout, const QVector<LogLine::Segment>& highlights)
+{
+    QTextOption option;
+    option.setWrapMode(m_wrap ? QTextOption::WrapAtWordBoundaryOrAnywhere : QTextOption::NoWrap);
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
+    QList<QTextLayout::FormatRange> formats;
+#else
+    QVector<QTextLayout::FormatRange> formats;
+#endif
+    if (!m_deviceFacade.isNull())
+    {
+        const DeviceFacade* const deviceFacade = m_deviceFacade.data();
+        formats.reserve(line.segments.size());
+        for (const LogLine::Segment& segment : line.segments)
+        {
+            QTextLayout::FormatRange range;
+            range.start = segment.position;
+            range.length = segment.length;
+            range.format = deviceFacade->getThemeFormat(segment.color);
+            formats.append(range);
+        }
+
+        // the highlights come after the segments, so their colors replace the segment ones
+        for (const LogLine::Segment& highlight : highlights)
+        {
+            QTextLayout::FormatRange range;
+            range.start = highlight.position;
+            range.length = highlight.length;
+            range.format = deviceFacade->getThemeFormat(highlight.color);
+            formats.append(range);
+        }
+    }
+
+    layout.setFont(font());
+    layout.setTextOption(option);
+    layout.setText(line.text);
+#if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
+    layout.setAdditionalFormats(formats);
+#else
+    layout.setFormats(formats);
+#endif
+
+    const int lineSpacing = getLineSpacing();
+    const int width = viewport()->width();
+    layout.beginLayout();
+    for (int lines = 0;; ++lines)
+    {
+        QTextLine textLine = layout.createLine();
+        if (!textLine.isValid())
+        {
+            break;
+        }
+
+        if (m_wrap)
+        {
+            textLine.setLineWidth(width);
+        }
+        else
+        {
+            textLine.setNumColumns(std::numeric_limits<int>::max());
+        }
+        textLine.setPosition(QPointF(0, lines * lineSpacing));
+    }
+    layout.endLayout();
+}
+
+bool LogView::canDrawGlyphs(const LogLine& line) const
+{
+    return m_glyphCache.canDraw(line.text)
+        && (!m_wrap || m_glyphCache.getTextWidth(line.text.size()) <= viewport()->width());
+}
+
+const LogView::GlyphRow& LogView::getGlyphRow(const int row, const LogLine& line)
+{
+    const quint64 id = m_model.at(row);
+    const auto it = m_glyphRows.constFind(id);
+    if (it != m_glyphRows.constEnd())
+    {
+        return *it;
+    }
+
+    GlyphRow glyphRow;
+    const auto addRun = [&](const int begin, const int end, const int color)
+    {
+        if (begin < end)
+        {
+            glyphRow.runs.append(m_glyphCache.createGlyphRun(line.text.midRef(begin, end - begin), m_glyphCache.getTextWidth(begin)));
+            glyphRow.colors.append(color);
+        }
+    };
+
+    int end = 0;
+    for (const LogLine::Segment& segment : line.segments)
+    {
+        addRun(end, segment.position, GlyphRow::TEXT_COLOR);
+        end = segment.position + segment.length;
+        addRun(segment.position, end, segment.color);
+    }
+    addRun(end, line.text.size(), GlyphRow::TEXT_COLOR);
+
+    if (m_glyphRows.size() >= MAX_CACHED_GLYPH_ROWS)
+    {
+        m_glyphRows.clear();
+    }
+    return *m_glyphRows.insert(id, glyphRow);
+}
+
+void LogView::drawGlyphs(QPainter& painter, const GlyphRow& glyphRow, const QVector<LogLine::Segment>& highlights, const QPointF& position) const
+{
+    const QColor textColor = palette().text().color();
+    const DeviceFacade* const deviceFacade = m_deviceFacade.data();
+
+    // the colors are looked up while painting, so the runs stay valid when the theme changes
+    for (int i = 0; i < glyphRow.runs.size(); ++i)
+    {
+        const int color = glyphRow.colors[i];
+        painter.setPen(deviceFacade != nullptr && color != GlyphRow::TEXT_COLOR
+            ? deviceFacade->getThemeFormat(static_cast<ColorTheme::ColorType>(color)).foreground().color()
+            : textColor);
+        painter.drawGlyphRun(position, glyphRow.runs[i]);
+    }
+
+    // the highlighted text is drawn again over the highlight, in the highlight's own text color
+    if (deviceFacade != nullptr && !highlights.isEmpty())
+    {
+        painter.save();
+        for (const LogLine::Segment& highlight : highlights)
+        {
+            const QRectF rect(
+                position.x() + m_glyphCache.getTextWidth(highlight.position),
+                position.y(),
+                m_glyphCache.getTextWidth(highlight.length),
+                getLineSpacing()
+            );
+            const QTextCharFormat& format = deviceFacade->getThemeFormat(highlight.color);
+            painter.fillRect(rect, format.background());
+            painter.setClipRect(rect);
+            painter.setPen(format.foreground().color());
+            for (const QGlyphRun& run : glyphRow.runs)
+            {
+                painter.drawGlyphRun(position, run);
+            }
+        }
+        painter.restore();
+    }
+    painter.setPen(textColor);
+}
+
+int LogView::getRowHeight(const int row)
+{
+    if (!m_wrap)
+    {
+        return getLineSpacing();
+    }
+
+    const quint64 id = m_model.at(row);
+    const auto it = m_rowHeights.constFind(id);
+    if (it != m_rowHeights.constEnd())
+    {
+        return *it;
+    }
+
+    int height = getLineSpacing();
+    const LogLine& line = formatRow(row);
+    if (!canDrawGlyphs(line))
+    {
+        QTextLayout layout;
+        layoutLine(line, layout);
+        height *= qMax(1, layout.lineCount());
+    }
+
+    if (m_rowHeights.size() >= MAX_CACHED_ROW_HEIGHTS)
+    {
+        m_rowHeights.clear();
+    }
+    m_rowHeights.insert(id, height);
+    return height;
+}
+
+void LogView::updateRowHeightsKey()
+{
+    // the heights of the wrapped rows only depend on the width and the font,
+    // so they're kept for when the window is resized back or the font restored
+    const QPair<int, QString> key(viewport()->width(), font().key());
+    if (key == m_rowHeightsKey)
+    {
+        return;
+    }
+
+    if (!m_rowHeights.isEmpty())
+    {
+        m_rowHeightsCache.insert(m_rowHeightsKey, m_rowHeights);
+    }
+    m_rowHeights.clear();
+    m_rowHeightsCache.take(key, m_rowHeights);
+    m_rowHeightsKey = key;
+}
+
+int LogView::getRowsFittingAtEnd()
+{
+    const int height = viewport()->height();
+    if (!m_wrap)
+    {
+        return qMax(1, height / getLineSpacing());
+    }
+
+    int rows = 0;
+    for (int row = m_model.size() - 1, y = 0; row >= 0; --row, ++rows)
+    {
+        y += getRowHeight(row);
+        if (y > height)
+        {
+            break;
+        }
+    }
+    return qMax(1, rows);
+}
+
+int LogView::getRowAt(const int y) const
+{
+    if (m_model.isEmpty())
+    {
+        return -1;
+    }
+
+    const int firstRow = verticalScrollBar()->value();
+    const auto it = std::upper_bound(m_paintedRowBottoms.constBegin(), m_paintedRowBottoms.constEnd(), y);
+    const int row = firstRow + static_cast<int>(it - m_paintedRowBottoms.constBegin());
+    return qBound(0, row, m_model.size() - 1);
+}
+
+void LogView::removeRows(const int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    QScrollBar& sb = *verticalScrollBar();
+    sb.setValue(sb.value() - count);
+
+    if (m_selectionAnchor >= 0)
+    {
+        m_selectionAnchor -= count;
+        m_selectionEnd -= count;
+        if (m_selectionAnchor < 0 && m_selectionEnd < 0)
+        {
+            m_selectionAnchor = -1;
+            m_selectionEnd = -1;
+        }
+        else
+        {
+            m_selectionAnchor = qMax(0, m_selectionAnchor);
+            m_selectionEnd = qMax(0, m_selectionEnd);
+        }
+    }
+}
+
+void LogView::updateScrollBars()
+{
+    QScrollBar& vsb = *verticalScrollBar();
+    const int fittingRows = getRowsFittingAtEnd();
+    vsb.setRange(0, qMax(0, m_model.size() - fittingRows));
+    vsb.setPageStep(fittingRows);
+    vsb.setSingleStep(1);
+
+    QScrollBar& hsb = *horizontalScrollBar();
+    const int width = viewport()->width();
+    hsb.setRange(0, m_wrap ? 0 : qMax(0, m_maxLineWidth - width));
+    hsb.setPageStep(width);
+    hsb.setSingleStep(QFontMetrics(font()).averageCharWidth());
+}
+
+void LogView::copySelection() const
+{
+    if (m_selectionAnchor < 0)
+    {
+        return;
+    }
+
+    QStringList lines;
+    const int last = qMin(qMax(m_selectionAnchor, m_selectionEnd), m_model.size() - 1);
+    for (int row = qMin(m_selectionAnchor, m_selectionEnd); row <= last; ++row)
+    {
+        QString text = formatRow(row, false).text;
+        while (text.endsWith(' '))
+        {
+            text.chop(1);
+        }
+        lines.append(text);
+    }
+    QApplication::clipboard()->setText(lines.join('\n'));
+}
+
+void LogView::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(viewport());
+    painter.fillRect(event->rect(), palette().base());
+    painter.setPen(palette().text().color());
+
+    const int width = viewport()->width();
+    const int height = viewport()->height();
+    const int x = m_wrap ? 0 : -horizontalScrollBar()->value();
+    const int selectionBegin = qMin(m_selectionAnchor, m_selectionEnd);
+    const int selectionEnd = qMax(m_selectionAnchor, m_selectionEnd);
+    const int maxLineWidth = m_maxLineWidth;
+    const int lineSpacing = getLineSpacing();
+
+    m_paintedRowBottoms.clear();
+    QTextLayout layout;
+    int y = 0;
+    for (int row = verticalScrollBar()->value(); row < m_model.size() && y < height; ++row)
+    {
+        const LogLine& line = formatRow(row);
+        const QVector<LogLine::Segment>& highlights = getHighlights(row, line);
+        const bool glyphs = canDrawGlyphs(line);
+        int rowHeight = lineSpacing;
+        if (!glyphs)
+        {
+            layoutLine(line, layout, highlights);
+            rowHeight *= qMax(1, layout.lineCount());
+        }
+
+        if (row >= selectionBegin && row <= selectionEnd)
+        {
+            painter.fillRect(0, y, width, rowHeight, palette().highlight());
+        }
+
+        if (glyphs)
+        {
+            drawGlyphs(painter, getGlyphRow(row, line), highlights, QPointF(x, y));
+        }
+        else
+        {
+            layout.draw(&painter, QPointF(x, y));
+        }
+
+        if (m_wrap)
+        {
+            m_rowHeights.insert(m_model.at(row), rowHeight);
+        }
+        else if (glyphs)
+        {
+            m_maxLineWidth = qMax(m_maxLineWidth, qCeil(m_glyphCache.getTextWidth(line.text.size())));
+        }
+        else if (layout.lineCount() > 0)
+        {
+            m_maxLineWidth = qMax(m_maxLineWidth, qCeil(layout.lineAt(0).naturalTextWidth()));
+        }
+
+        y += rowHeight;
+        m_paintedRowBottoms.append(y);
+    }
+
+    if (m_maxLineWidth != maxLineWidth)
+    {
+        // the width of the lines is only known once they're painted
+        updateScrollBars();
+    }
+}
+
+void LogView::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+
+    const bool atEnd = isAtEnd();
+    updateRowHeightsKey();
+    updateScrollBars();
+    updateNewLinesButton();
+    updateBanner();
+
+    if (atEnd)
+    {
+        scrollToEnd();
+    }
+}
+
+void LogView::changeEvent(QEvent* event)
+{
+    QAbstractScrollArea::changeEvent(event);
+
+    if (event->type() == QEvent::FontChange)
+    {
+        m_glyphCache.setFont(font());
+        m_glyphRows.clear();
+        updateRowHeightsKey();
+        m_maxLineWidth = 0;
+        updateScrollBars();
+    }
+}
+
+void LogView::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton)
+    {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+
+    const int row = getRowAt(event->pos().y());
+    if ((event->modifiers() & Qt::ShiftModifier) == 0 || m_selectionAnchor < 0)
+    {
+        m_selectionAnchor = row;
+    }
+    m_selectionEnd = row;
+    viewport()->update();
+}
+
+void LogView::mouseMoveEvent(QMouseEvent* event)
+{
+    if ((event->buttons() & Qt::LeftButton) == 0 || m_selectionAnchor < 0)
+    {
+        QAbstractScrollArea::mouseMoveEvent(event);
+        return;
+    }
+
+    // dragging out of the viewport scrolls it
+    QScrollBar& sb = *verticalScrollBar();
+    if (event->pos().y() < 0)
+    {
+        sb.setValue(sb.value() - 1);
+    }
+    else if (event->pos().y() >= viewport()->height())
+    {
+        sb.setValue(sb.value() + 1);
+    }
+
+    m_selectionEnd = getRowAt(event->pos().y());
+    viewport()->update();
+}
+
+void LogView::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton || m_model.isEmpty())
+    {
+        QAbstractScrollArea::mouseDoubleClickEvent(event);
+        return;
+    }
+
+    expandRow(getRowAt(event->pos().y()));
+}
+
+void LogView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy))
+    {
+        copySelection();
+    }
+    else if (event->matches(QKeySequence::SelectAll) && !m_model.isEmpty())
+    {
+        m_selectionAnchor = 0;
+        m_selectionEnd = m_model.size() - 1;
+        viewport()->update();
+    }
+    else
+    {
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
+
+void LogView::scrollContentsBy(int dx, int dy)
+{
+    // the scroll bars count rows rather than pixels
+    (void) dx;
+    (void) dy;
+    viewport()->update();
+}
+
+void LogView::onScrolled(const int value)
+{
+    const QScrollBar& sb = *verticalScrollBar();
+    if (value == sb.minimum() && sb.maximum() > sb.minimum())
+    {
+        emit scrolledToTop();
+    }
+    else if (value == sb.maximum() && !m_scrollLock && !m_pendingRows.isEmpty())
+    {
+        // scrolling back to the end resumes the live rows
+        appendPendingRows();
+    }
+}
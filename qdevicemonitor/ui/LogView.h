@@ -0,0 +1,178 @@
+/*
+    This file is part of QDeviceMonitor.
+
+    QDeviceMonitor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    QDeviceMonitor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with QDeviceMonitor. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include "devices/DeviceFacade.h"
+#include "LruCache.h"
+#include "ui/GlyphCache.h"
+#include "ui/LogModel.h"
+
+#include <QAbstractScrollArea>
+#include <QGlyphRun>
+#include <QHash>
+#include <QLabel>
+#include <QPainter>
+#include <QPair>
+#include <QPointer>
+#include <QPushButton>
+#include <QSet>
+#include <QScrollBar>
+#include <QStringList>
+#include <QTextLayout>
+#include <QTimer>
+#include <QVector>
+
+// Displays a LogModel, only the rows in the viewport are formatted, laid out and painted.
+// It scrolls by rows, so the scroll bar doesn't depend on the height of the other rows.
+// Wrapped row heights are computed lazily and kept for a few recent widths and fonts.
+// Rows of printable ASCII in a monospace font are painted from the GlyphCache instead,
+// their glyph runs are kept for the recently painted rows.
+// Records longer than maxLineLength are cut, so are their layouts, until they're expanded.
+class LogView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+    // the runs are in the order they're drawn, each one in the color of its segment
+    // or, for the text between the segments, in the text color of the palette
+    struct GlyphRow
+    {
+        static const int TEXT_COLOR = -1;
+
+        QVector<QGlyphRun> runs;
+        QVector<int> colors;
+    };
+
+    static const int MAX_CACHED_ROW_HEIGHTS = 16 * 1024;
+    static const int ROW_HEIGHTS_CACHE_SIZE = 4;
+    static const int MAX_CACHED_HIGHLIGHTS = 16 * 1024;
+    static const int MAX_CACHED_GLYPH_ROWS = 1024;
+    static const int FRAME_INTERVAL = 16;
+    static const int NEW_LINES_BUTTON_MARGIN = 8;
+
+    LogModel m_model;
+    QVector<quint64> m_pendingRows;
+    QTimer m_frameTimer;
+    quint64 m_firstId;
+    bool m_scrollLock;
+    int m_newLineCount;
+    QPushButton m_newLinesButton;
+    QLabel m_banner;
+    const LogSource* m_source;
+    QPointer<DeviceFacade> m_deviceFacade;
+    bool m_wrap;
+    int m_maxLineWidth;
+    int m_maxLineLength;
+    QSet<quint64> m_expandedRows;
+    int m_selectionAnchor;
+    int m_selectionEnd;
+    QVector<int> m_paintedRowBottoms;
+    QHash<quint64, int> m_rowHeights;
+    QPair<int, QString> m_rowHeightsKey;
+    LruCache<QPair<int, QString>, QHash<quint64, int>> m_rowHeightsCache;
+    GlyphCache m_glyphCache;
+    QHash<quint64, GlyphRow> m_glyphRows;
+    QStringList m_highlightTerms;
+    Qt::CaseSensitivity m_highlightCaseSensitivity;
+    QHash<quint64, QVector<LogLine::Segment>> m_highlights;
+    mutable LogLine m_line;
+
+public:
+    explicit LogView(QWidget* parent = nullptr);
+
+    inline const LogModel& getModel() const { return m_model; }
+    inline void setSource(const LogSource* source) { m_source = source; }
+    inline void setDeviceFacade(QPointer<DeviceFacade> deviceFacade) { m_deviceFacade = deviceFacade; }
+    void setWrap(const bool wrap);
+    void setMaxRows(const int maxRows);
+    void setMaxLineLength(const int maxLineLength);
+    void setScrollLock(const bool scrollLock);
+
+    // records are appended by the next frame, along with all the others added until then;
+    // while the view is scroll locked or scrolled up, they're held back and only counted
+    void appendRecord(const quint64 id);
+    void appendExtraLine(const LogLine& line);
+    void prependRecords(const QVector<quint64>& ids);
+    void trim(const quint64 firstId);
+
+    bool isAtEnd() const;
+    bool isPaused() const;
+    void scrollToEnd();
+    int getVisibleLineCount() const;
+    inline int getFirstVisibleRow() const { return verticalScrollBar()->value(); }
+
+    // the end of the selection, or -1 if nothing is selected
+    inline int getCursorRow() const { return m_selectionEnd; }
+    void selectRow(const int row);
+
+    // the terms are looked up in the painted rows only, and highlighted rather than filtered
+    void setHighlightTerms(const QStringList& terms, const Qt::CaseSensitivity cs);
+
+    // shown over the top of the rows unless it's empty
+    void setBanner(const QString& text);
+
+    // clears the view and frees the memory held for its rows
+    void release();
+
+    // clears the view for good: the records older than endId aren't shown again
+    void clearUpTo(const quint64 endId);
+
+public slots:
+    void clear();
+
+signals:
+    void scrolledToTop();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void changeEvent(QEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private slots:
+    void onScrolled(const int value);
+    void flushPendingRows();
+    void showNewLines();
+
+private:
+    const LogLine& formatRow(const int row, const bool truncate = true) const;
+    void expandRow(const int row);
+    const QVector<LogLine::Segment>& getHighlights(const int row, const LogLine& line);
+    void layoutLine(const LogLine& line, QTextLayout& layout, const QVector<LogLine::Segment>& highlights = QVector<LogLine::Segment>());
+    bool canDrawGlyphs(const LogLine& line) const;
+    const GlyphRow& getGlyphRow(const int row, const LogLine& line);
+    void drawGlyphs(QPainter& painter, const GlyphRow& glyphRow, const QVector<LogLine::Segment>& highlights, const QPointF& position) const;
+    int getRowHeight(const int row);
+    void updateRowHeightsKey();
+    int getLineSpacing() const;
+    int getRowsFittingAtEnd();
+    int getRowAt(const int y) const;
+    void removeRows(const int count);
+    void appendPendingRows();
+    void updateNewLinesButton();
+    void updateBanner();
+    void maybeScrollToEnd();
+    void updateScrollBars();
+    void copySelection() const;
+};
+
+#endif // LOGVIEW_H
@@ -92,7 +92,7 @@ void MainWindow::on_actionSettings_triggered()
     {
         dialog.saveSettings(s);
         loadSettings();
-        m_deviceFacade->allDevicesReloadText();
+        m_deviceFacade->allDevicesApplySettings();
     }
 }
 
@@ -129,7 +129,11 @@ void MainWindow::on_tabWidget_tabCloseRequested(const int index)
 
 void MainWindow::keyReleaseEvent(QKeyEvent* event)
 {
-    if (event->modifiers() & Qt::ControlModifier)
+    if (event->key() == Qt::Key_F3)
+    {
+        m_deviceFacade->findMatch((event->modifiers() & Qt::ShiftModifier) != 0);
+    }
+    else if (event->modifiers() & Qt::ControlModifier)
     {
         switch (event->key())
         {
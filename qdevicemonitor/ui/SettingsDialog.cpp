@@ -42,6 +42,9 @@ void SettingsDialog::loadSettings(const QSettings& s)
     m_ui->clearAndroidLogCheckBox->setChecked(s.value("clearAndroidLog").toBool());
     m_ui->autoRemoveFilesOlderThanSpinBox->setValue(s.value("autoRemoveFilesHours").toInt());
     m_ui->editorLineEdit->setText(s.value("textEditorPath").toString());
+    m_ui->trigramIndexCheckBox->setChecked(s.value("trigramIndex").toBool());
+    m_ui->releaseHiddenTabsSpinBox->setValue(s.value("releaseHiddenTabsMinutes").toInt());
+    m_ui->maxLineLengthSpinBox->setValue(s.value("maxLineLength").toInt());
 }
 
 void SettingsDialog::saveSettings(QSettings& s)
@@ -54,6 +57,9 @@ void SettingsDialog::saveSettings(QSettings& s)
     s.setValue("clearAndroidLog", m_ui->clearAndroidLogCheckBox->isChecked());
     s.setValue("autoRemoveFilesHours", m_ui->autoRemoveFilesOlderThanSpinBox->value());
     s.setValue("textEditorPath", m_ui->editorLineEdit->text());
+    s.setValue("trigramIndex", m_ui->trigramIndexCheckBox->isChecked());
+    s.setValue("releaseHiddenTabsMinutes", m_ui->releaseHiddenTabsSpinBox->value());
+    s.setValue("maxLineLength", m_ui->maxLineLengthSpinBox->value());
     s.sync();
 }
 
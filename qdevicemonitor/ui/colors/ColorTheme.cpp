@@ -19,8 +19,8 @@
 #include "DarkColorTheme.h"
 #include "LightColorTheme.h"
 
-class DarkColorTheme;
-class LightColorTheme;
+constexpr Qt::GlobalColor DarkColorTheme::COLORS[];
+constexpr Qt::GlobalColor LightColorTheme::COLORS[];
 
 QSharedPointer<ColorTheme> ColorTheme::create(const bool darkTheme)
 {
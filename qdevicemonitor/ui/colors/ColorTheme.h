@@ -36,9 +36,14 @@ public:
         DateTime,
         Pid,
         Tid,
-        Tag
+        Tag,
+
+        Highlight,
+        HighlightText
     };
 
+    static const int COLOR_TYPES = HighlightText + 1;
+
     static QSharedPointer<ColorTheme> create(const bool darkTheme);
 
     virtual Qt::GlobalColor getColor(const ColorType type) const = 0;
@@ -19,33 +19,31 @@
 #define DARKCOLORTHEME_H
 
 #include "ColorTheme.h"
-#include <QVector>
 
 class DarkColorTheme : public ColorTheme
 {
-    QVector<Qt::GlobalColor> m_colors;
-
 public:
-    DarkColorTheme()
-        : m_colors({
-            Qt::red,
-            Qt::red,
-            Qt::yellow,
-            Qt::green,
-            Qt::lightGray,
-            Qt::white,
-
-            Qt::lightGray,
-            Qt::green,
-            Qt::blue,
-            Qt::yellow
-        })
-    {
-    }
+    static constexpr Qt::GlobalColor COLORS[] = {
+        Qt::red,
+        Qt::red,
+        Qt::yellow,
+        Qt::green,
+        Qt::lightGray,
+        Qt::white,
+
+        Qt::lightGray,
+        Qt::green,
+        Qt::blue,
+        Qt::yellow,
+
+        Qt::yellow,
+        Qt::black
+    };
+    static_assert(sizeof(COLORS) / sizeof(COLORS[0]) == COLOR_TYPES, "every ColorType needs a color");
 
     Qt::GlobalColor getColor(const ColorType type) const override
     {
-        return m_colors[type];
+        return COLORS[type];
     }
 };
 
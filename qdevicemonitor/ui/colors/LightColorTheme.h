@@ -19,33 +19,31 @@
 #define LIGHTCOLORTHEME_H
 
 #include "ColorTheme.h"
-#include <QVector>
 
 class LightColorTheme : public ColorTheme
 {
-    QVector<Qt::GlobalColor> m_colors;
-
 public:
-    LightColorTheme()
-        : m_colors({
-            Qt::red,
-            Qt::red,
-            Qt::darkYellow,
-            Qt::darkGreen,
-            Qt::blue,
-            Qt::black,
-
-            Qt::black,
-            Qt::darkBlue,
-            Qt::blue,
-            Qt::darkGreen
-        })
-    {
-    }
+    static constexpr Qt::GlobalColor COLORS[] = {
+        Qt::red,
+        Qt::red,
+        Qt::darkYellow,
+        Qt::darkGreen,
+        Qt::blue,
+        Qt::black,
+
+        Qt::black,
+        Qt::darkBlue,
+        Qt::blue,
+        Qt::darkGreen,
+
+        Qt::yellow,
+        Qt::black
+    };
+    static_assert(sizeof(COLORS) / sizeof(COLORS[0]) == COLOR_TYPES, "every ColorType needs a color");
 
     Qt::GlobalColor getColor(const ColorType type) const override
     {
-        return m_colors[type];
+        return COLORS[type];
     }
 };
 